@@ -22,7 +22,7 @@
 #include "a2x_pack_mem.v.h"
 
 typedef unsigned long AChunk;
-#define A__BITS_PER_CHUNK (unsigned)(sizeof(AChunk) * 8)
+#define A__BITS_PER_CHUNK A__BITFIELD_BITS_PER_CHUNK
 #define a__BITS_PER_CHUNK_MASK (A__BITS_PER_CHUNK - 1)
 
 struct ABitfield {
@@ -46,7 +46,7 @@ ABitfield* a_bitfield_new(unsigned NumBits)
 
 void a_bitfield_free(ABitfield* Bitfield)
 {
-    free(Bitfield);
+    a_mem_free(Bitfield);
 }
 
 void a_bitfield_set(ABitfield* Bitfield, unsigned Bit)
@@ -84,3 +84,79 @@ bool a_bitfield_testMask(const ABitfield* Bitfield, const ABitfield* Mask)
 
     return true;
 }
+
+bool a_bitfield_testAny(const ABitfield* Bitfield, const ABitfield* Mask)
+{
+    for(unsigned i = Mask->numChunks; i--; ) {
+        if(Bitfield->bits[i] & Mask->bits[i]) {
+            return true;
+        }
+    }
+
+    return false;
+}
+
+void a_bitfield_copy(ABitfield* Dst, const ABitfield* Src)
+{
+    memcpy(Dst->bits, Src->bits, Dst->numChunks * sizeof(AChunk));
+}
+
+void a_bitfield_and(ABitfield* Dst, const ABitfield* Src)
+{
+    for(unsigned i = Dst->numChunks; i--; ) {
+        Dst->bits[i] &= Src->bits[i];
+    }
+}
+
+void a_bitfield_or(ABitfield* Dst, const ABitfield* Src)
+{
+    for(unsigned i = Dst->numChunks; i--; ) {
+        Dst->bits[i] |= Src->bits[i];
+    }
+}
+
+void a_bitfield_andNot(ABitfield* Dst, const ABitfield* Src)
+{
+    for(unsigned i = Dst->numChunks; i--; ) {
+        Dst->bits[i] &= ~Src->bits[i];
+    }
+}
+
+unsigned a_bitfield_count(const ABitfield* Bitfield)
+{
+    unsigned n = 0;
+
+    for(unsigned i = Bitfield->numChunks; i--; ) {
+        n += a__bitfield_popcount(Bitfield->bits[i]);
+    }
+
+    return n;
+}
+
+bool a_bitfield_equal(const ABitfield* A, const ABitfield* B)
+{
+    return A->numChunks == B->numChunks
+        && memcmp(A->bits, B->bits, A->numChunks * sizeof(AChunk)) == 0;
+}
+
+unsigned a_bitfield_hash(const ABitfield* Bitfield)
+{
+    // FNV-1a over each chunk's value, low byte first. Hashes still depend on
+    // the chunk size, so they are not meant to be shared between platforms
+    uint32_t hash = 2166136261u;
+
+    for(unsigned i = 0; i < Bitfield->numChunks; i++) {
+        AChunk c = Bitfield->bits[i];
+
+        for(unsigned b = (unsigned)sizeof(AChunk); b--; c >>= 8) {
+            hash = (hash ^ (uint32_t)(c & 0xff)) * 16777619u;
+        }
+    }
+
+    return hash;
+}
+
+ABitfieldIt a__bitfieldit_new(const ABitfield* Bitfield)
+{
+    return a__bitfieldit_fromChunks(Bitfield->bits, Bitfield->numChunks);
+}
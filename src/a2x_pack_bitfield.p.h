@@ -21,6 +21,22 @@
 #include "a2x_system_includes.h"
 
 typedef struct ABitfield ABitfield;
+typedef struct ABitfieldIt ABitfieldIt;
+typedef struct ABitfieldFixed ABitfieldFixed;
+
+#define A__BITFIELD_BITS_PER_CHUNK (unsigned)(sizeof(unsigned long) * 8)
+#define A_BITFIELD_FIXED_BITS 128
+
+struct ABitfieldIt {
+    const unsigned long* chunks;
+    unsigned numChunks;
+    unsigned chunk;
+    unsigned long current;
+};
+
+struct ABitfieldFixed {
+    unsigned long bits[A_BITFIELD_FIXED_BITS / (sizeof(unsigned long) * 8)];
+};
 
 extern ABitfield* a_bitfield_new(unsigned NumBits);
 extern void a_bitfield_free(ABitfield* Bitfield);
@@ -31,3 +47,194 @@ extern void a_bitfield_reset(ABitfield* Bitfield);
 
 extern bool a_bitfield_test(const ABitfield* Bitfield, unsigned Bit);
 extern bool a_bitfield_testMask(const ABitfield* Bitfield, const ABitfield* Mask);
+extern bool a_bitfield_testAny(const ABitfield* Bitfield, const ABitfield* Mask);
+
+extern void a_bitfield_copy(ABitfield* Dst, const ABitfield* Src);
+extern void a_bitfield_and(ABitfield* Dst, const ABitfield* Src);
+extern void a_bitfield_or(ABitfield* Dst, const ABitfield* Src);
+extern void a_bitfield_andNot(ABitfield* Dst, const ABitfield* Src);
+
+extern unsigned a_bitfield_count(const ABitfield* Bitfield);
+extern bool a_bitfield_equal(const ABitfield* A, const ABitfield* B);
+extern unsigned a_bitfield_hash(const ABitfield* Bitfield);
+
+static inline unsigned a__bitfield_ctz(unsigned long Chunk)
+{
+    #if defined(__GNUC__)
+        return (unsigned)__builtin_ctzl(Chunk);
+    #else
+        unsigned n = 0;
+
+        while((Chunk & 1) == 0) {
+            Chunk >>= 1;
+            n++;
+        }
+
+        return n;
+    #endif
+}
+
+static inline unsigned a__bitfield_popcount(unsigned long Chunk)
+{
+    #if defined(__GNUC__)
+        return (unsigned)__builtin_popcountl(Chunk);
+    #else
+        unsigned n = 0;
+
+        for(; Chunk; Chunk &= Chunk - 1) {
+            n++;
+        }
+
+        return n;
+    #endif
+}
+
+static inline ABitfieldIt a__bitfieldit_fromChunks(const unsigned long* Chunks, unsigned NumChunks)
+{
+    ABitfieldIt it;
+
+    it.chunks = Chunks;
+    it.numChunks = NumChunks;
+    it.chunk = 0;
+    it.current = Chunks[0];
+
+    return it;
+}
+
+static inline bool a__bitfieldit_getNext(ABitfieldIt* Iterator, unsigned* Bit)
+{
+    while(Iterator->current == 0) {
+        if(++Iterator->chunk >= Iterator->numChunks) {
+            return false;
+        }
+
+        Iterator->current = Iterator->chunks[Iterator->chunk];
+    }
+
+    *Bit = Iterator->chunk * A__BITFIELD_BITS_PER_CHUNK
+            + a__bitfield_ctz(Iterator->current);
+
+    Iterator->current &= Iterator->current - 1;
+
+    return true;
+}
+
+extern ABitfieldIt a__bitfieldit_new(const ABitfield* Bitfield);
+
+#define A__BITFIELD_ITERATE(Iterator, Name)                             \
+    for(ABitfieldIt a__bit = Iterator;                                  \
+        a__bit.chunks != NULL;                                          \
+        a__bit.chunks = NULL)                                           \
+        for(unsigned Name; a__bitfieldit_getNext(&a__bit, &Name); )
+
+#define A_BITFIELD_ITERATE(Bitfield, Name) \
+    A__BITFIELD_ITERATE(a__bitfieldit_new(Bitfield), Name)
+
+#define A_BITFIELD_FIXED_ITERATE(Bitfield, Name)                        \
+    A__BITFIELD_ITERATE(                                                \
+        a__bitfieldit_fromChunks((Bitfield)->bits,                      \
+                                 (unsigned)A_ARRAY_LEN((Bitfield)->bits)), \
+        Name)
+
+static inline void a_bitfieldfixed_reset(ABitfieldFixed* Bitfield)
+{
+    memset(Bitfield->bits, 0, sizeof(Bitfield->bits));
+}
+
+static inline void a_bitfieldfixed_set(ABitfieldFixed* Bitfield, unsigned Bit)
+{
+    Bitfield->bits[Bit / A__BITFIELD_BITS_PER_CHUNK] |=
+        1ul << (Bit % A__BITFIELD_BITS_PER_CHUNK);
+}
+
+static inline void a_bitfieldfixed_clear(ABitfieldFixed* Bitfield, unsigned Bit)
+{
+    Bitfield->bits[Bit / A__BITFIELD_BITS_PER_CHUNK] &=
+        ~(1ul << (Bit % A__BITFIELD_BITS_PER_CHUNK));
+}
+
+static inline bool a_bitfieldfixed_test(const ABitfieldFixed* Bitfield, unsigned Bit)
+{
+    return (Bitfield->bits[Bit / A__BITFIELD_BITS_PER_CHUNK]
+                & (1ul << (Bit % A__BITFIELD_BITS_PER_CHUNK))) != 0;
+}
+
+static inline bool a_bitfieldfixed_testMask(const ABitfieldFixed* Bitfield, const ABitfieldFixed* Mask)
+{
+    unsigned long miss = 0;
+
+    for(unsigned i = A_ARRAY_LEN(Bitfield->bits); i--; ) {
+        miss |= Mask->bits[i] & ~Bitfield->bits[i];
+    }
+
+    return miss == 0;
+}
+
+static inline bool a_bitfieldfixed_testAny(const ABitfieldFixed* Bitfield, const ABitfieldFixed* Mask)
+{
+    unsigned long hit = 0;
+
+    for(unsigned i = A_ARRAY_LEN(Bitfield->bits); i--; ) {
+        hit |= Mask->bits[i] & Bitfield->bits[i];
+    }
+
+    return hit != 0;
+}
+
+static inline void a_bitfieldfixed_and(ABitfieldFixed* Dst, const ABitfieldFixed* Src)
+{
+    for(unsigned i = A_ARRAY_LEN(Dst->bits); i--; ) {
+        Dst->bits[i] &= Src->bits[i];
+    }
+}
+
+static inline void a_bitfieldfixed_or(ABitfieldFixed* Dst, const ABitfieldFixed* Src)
+{
+    for(unsigned i = A_ARRAY_LEN(Dst->bits); i--; ) {
+        Dst->bits[i] |= Src->bits[i];
+    }
+}
+
+static inline void a_bitfieldfixed_andNot(ABitfieldFixed* Dst, const ABitfieldFixed* Src)
+{
+    for(unsigned i = A_ARRAY_LEN(Dst->bits); i--; ) {
+        Dst->bits[i] &= ~Src->bits[i];
+    }
+}
+
+static inline unsigned a_bitfieldfixed_count(const ABitfieldFixed* Bitfield)
+{
+    unsigned n = 0;
+
+    for(unsigned i = A_ARRAY_LEN(Bitfield->bits); i--; ) {
+        n += a__bitfield_popcount(Bitfield->bits[i]);
+    }
+
+    return n;
+}
+
+static inline bool a_bitfieldfixed_equal(const ABitfieldFixed* A, const ABitfieldFixed* B)
+{
+    unsigned long diff = 0;
+
+    for(unsigned i = A_ARRAY_LEN(A->bits); i--; ) {
+        diff |= A->bits[i] ^ B->bits[i];
+    }
+
+    return diff == 0;
+}
+
+static inline unsigned a_bitfieldfixed_hash(const ABitfieldFixed* Bitfield)
+{
+    uint32_t hash = 2166136261u;
+
+    for(unsigned i = 0; i < A_ARRAY_LEN(Bitfield->bits); i++) {
+        unsigned long c = Bitfield->bits[i];
+
+        for(unsigned b = (unsigned)sizeof(c); b--; c >>= 8) {
+            hash = (hash ^ (uint32_t)(c & 0xff)) * 16777619u;
+        }
+    }
+
+    return hash;
+}
@@ -50,9 +50,14 @@ static ASprite* g_titles[A_OUT__TYPE_NUM];
 static AButton* g_toggle;
 static bool g_show = A_CONFIG_OUTPUT_CONSOLE_SHOW;
 
+#if A_CONFIG_BUILD_DEBUG_MEM
+    static AButton* g_memToggle;
+    static bool g_memShow;
+#endif
+
 static void line_set(ALine* Line, AOutSource Source, AOutType Type, const char* Text)
 {
-    free(Line->text);
+    a_mem_free(Line->text);
 
     Line->source = Source;
     Line->type = Type;
@@ -71,8 +76,8 @@ static ALine* line_new(AOutSource Source, AOutType Type, const char* Text)
 
 static void line_free(ALine* Line)
 {
-    free(Line->text);
-    free(Line);
+    a_mem_free(Line->text);
+    a_mem_free(Line);
 }
 
 void a_console__init(void)
@@ -118,6 +123,11 @@ void a_console__init2(void)
         a_button_bind(g_toggle, A_BUTTON_R);
     a_button_bindComboEnd(g_toggle);
 
+    #if A_CONFIG_BUILD_DEBUG_MEM
+        g_memToggle = a_button_new();
+        a_button_bind(g_memToggle, A_KEY_F10);
+    #endif
+
     g_state = A_CONSOLE__STATE_FULL;
 }
 
@@ -136,6 +146,10 @@ void a_console__uninit(void)
     }
 
     a_button_free(g_toggle);
+
+    #if A_CONFIG_BUILD_DEBUG_MEM
+        a_button_free(g_memToggle);
+    #endif
 }
 
 void a_console__tick(void)
@@ -143,6 +157,65 @@ void a_console__tick(void)
     if(a_button_pressGetOnce(g_toggle)) {
         g_show = !g_show;
     }
+
+    #if A_CONFIG_BUILD_DEBUG_MEM
+        if(a_button_pressGetOnce(g_memToggle)) {
+            g_memShow = !g_memShow;
+        }
+    #endif
+}
+
+#if A_CONFIG_BUILD_DEBUG_MEM
+static void drawMemPage(void)
+{
+    const AMemStats* stats = a_mem__statsGet();
+    AMemSubsystem subs[8];
+    unsigned subsNum = a_mem__subsystemsGet(subs, A_ARRAY_LEN(subs));
+
+    a_font_coordsSet(2, a_font_coordsGetY());
+
+    a_font__fontSet(A_FONT__ID_YELLOW);
+    a_font_printf("%u KB live, %u KB peak\n",
+                  (unsigned)(stats->bytesLive / 1024),
+                  (unsigned)(stats->bytesPeak / 1024));
+
+    a_font__fontSet(A_FONT__ID_GREEN);
+    a_font_printf("%u live / %u total allocs\n",
+                  stats->numLive,
+                  stats->numTotal);
+
+    a_font__fontSet(stats->frameAllocs > 0
+                        ? A_FONT__ID_YELLOW : A_FONT__ID_GREEN);
+    a_font_printf("%u allocs (%u B) last frame, %u max\n",
+                  stats->frameAllocs,
+                  (unsigned)stats->frameBytes,
+                  stats->frameAllocsMax);
+
+    a_font__fontSet(A_FONT__ID_LIGHT_GRAY);
+
+    for(unsigned s = 0; s < subsNum; s++) {
+        a_font_printf("%s: %u KB in %u\n",
+                      subs[s].name,
+                      (unsigned)(subs[s].bytesLive / 1024),
+                      subs[s].numLive);
+    }
+}
+#endif
+
+static void drawLines(void)
+{
+    int tagWidth = g_sources[A_OUT__SOURCE_A2X]->w;
+
+    a_font_coordsSet(1 + tagWidth + 1 + tagWidth + 2, a_font_coordsGetY());
+    a_font__fontSet(A_FONT__ID_LIGHT_GRAY);
+
+    A_LIST_ITERATE(g_lines, ALine*, l) {
+        a_sprite_blit(g_sources[l->source], 1, a_font_coordsGetY());
+        a_sprite_blit(
+            g_titles[l->type], 1 + tagWidth + 1, a_font_coordsGetY());
+        a_font_print(l->text);
+        a_font_newLine();
+    }
 }
 
 void a_console__draw(void)
@@ -183,20 +256,15 @@ void a_console__draw(void)
                       A_CONFIG_APP_AUTHOR);
     }
 
-    {
-        int tagWidth = g_sources[A_OUT__SOURCE_A2X]->w;
-
-        a_font_coordsSet(1 + tagWidth + 1 + tagWidth + 2, a_font_coordsGetY());
-        a_font__fontSet(A_FONT__ID_LIGHT_GRAY);
-
-        A_LIST_ITERATE(g_lines, ALine*, l) {
-            a_sprite_blit(g_sources[l->source], 1, a_font_coordsGetY());
-            a_sprite_blit(
-                g_titles[l->type], 1 + tagWidth + 1, a_font_coordsGetY());
-            a_font_print(l->text);
-            a_font_newLine();
+    #if A_CONFIG_BUILD_DEBUG_MEM
+        if(g_memShow) {
+            drawMemPage();
+        } else {
+            drawLines();
         }
-    }
+    #else
+        drawLines();
+    #endif
 
     {
         a_font_alignSet(A_FONT_ALIGN_RIGHT);
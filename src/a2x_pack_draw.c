@@ -21,6 +21,27 @@
 #include "a2x_pack_pixel.v.h"
 #include "a2x_pack_screen.v.h"
 
+#define A__EDGE_CHUNK 64
+
+static void dirtyAddPoints(const AVectorInt* Points, unsigned NumPoints)
+{
+    if(NumPoints == 0) {
+        return;
+    }
+
+    int minX = Points[0].x, maxX = Points[0].x;
+    int minY = Points[0].y, maxY = Points[0].y;
+
+    for(unsigned p = 1; p < NumPoints; p++) {
+        minX = a_math_min(minX, Points[p].x);
+        maxX = a_math_max(maxX, Points[p].x);
+        minY = a_math_min(minY, Points[p].y);
+        maxY = a_math_max(maxY, Points[p].y);
+    }
+
+    a_screen__dirtyAdd(minX, minY, maxX - minX + 1, maxY - minY + 1);
+}
+
 void a_draw_fill(void)
 {
     a_pixel_push();
@@ -36,26 +57,64 @@ void a_draw_fill(void)
 
 void a_draw_pixel(int X, int Y)
 {
+    a_screen__dirtyAdd(X, Y, 1, 1);
+
     a_platform__drawPixel(X, Y);
 }
 
+void a_draw_pixels(const AVectorInt* Points, unsigned NumPoints)
+{
+    dirtyAddPoints(Points, NumPoints);
+
+    a_platform__drawPixels(Points, NumPoints);
+}
+
 void a_draw_line(int X1, int Y1, int X2, int Y2)
 {
+    a_screen__dirtyAdd(a_math_min(X1, X2),
+                       a_math_min(Y1, Y2),
+                       a_math_abs(X2 - X1) + 1,
+                       a_math_abs(Y2 - Y1) + 1);
+
     a_platform__drawLine(X1, Y1, X2, Y2);
 }
 
+void a_draw_lines(const AVectorInt* Points, unsigned NumLines)
+{
+    // Points are consecutive start and end pairs
+    dirtyAddPoints(Points, 2 * NumLines);
+
+    a_platform__drawLines(Points, NumLines);
+}
+
+void a_draw_lineAntialiased(int X1, int Y1, int X2, int Y2)
+{
+    a_screen__dirtyAdd(a_math_min(X1, X2),
+                       a_math_min(Y1, Y2),
+                       a_math_abs(X2 - X1) + 2,
+                       a_math_abs(Y2 - Y1) + 2);
+
+    a_platform__drawLineAntialiased(X1, Y1, X2, Y2);
+}
+
 void a_draw_hline(int X1, int X2, int Y)
 {
+    a_screen__dirtyAdd(a_math_min(X1, X2), Y, a_math_abs(X2 - X1) + 1, 1);
+
     a_platform__drawHLine(a_math_min(X1, X2), a_math_max(X1, X2), Y);
 }
 
 void a_draw_vline(int X, int Y1, int Y2)
 {
+    a_screen__dirtyAdd(X, a_math_min(Y1, Y2), 1, a_math_abs(Y2 - Y1) + 1);
+
     a_platform__drawVLine(X, a_math_min(Y1, Y2), a_math_max(Y1, Y2));
 }
 
 void a_draw_rectangle(int X, int Y, int Width, int Height)
 {
+    a_screen__dirtyAdd(X, Y, a_math_max(Width, 1), a_math_max(Height, 1));
+
     if(a_pixel__state.fillDraw) {
         a_platform__drawRectangleFilled(X, Y, Width, Height);
     } else {
@@ -63,11 +122,180 @@ void a_draw_rectangle(int X, int Y, int Width, int Height)
     }
 }
 
+void a_draw_rectangles(const AVectorInt* Rectangles, unsigned NumRectangles)
+{
+    if(NumRectangles == 0) {
+        return;
+    }
+
+    // Rectangles are consecutive {x, y}, {width, height} pairs
+    int minX = Rectangles[0].x;
+    int minY = Rectangles[0].y;
+    int maxX = minX + a_math_max(Rectangles[1].x, 1);
+    int maxY = minY + a_math_max(Rectangles[1].y, 1);
+
+    for(unsigned r = 1; r < NumRectangles; r++) {
+        const AVectorInt* rect = &Rectangles[2 * r];
+
+        minX = a_math_min(minX, rect[0].x);
+        minY = a_math_min(minY, rect[0].y);
+        maxX = a_math_max(maxX, rect[0].x + a_math_max(rect[1].x, 1));
+        maxY = a_math_max(maxY, rect[0].y + a_math_max(rect[1].y, 1));
+    }
+
+    a_screen__dirtyAdd(minX, minY, maxX - minX, maxY - minY);
+
+    if(a_pixel__state.fillDraw) {
+        a_platform__drawRectanglesFilled(Rectangles, NumRectangles);
+    } else {
+        a_platform__drawRectanglesOutline(Rectangles, NumRectangles);
+    }
+}
+
 void a_draw_circle(int X, int Y, int Radius)
 {
+    a_screen__dirtyAdd(X - Radius, Y - Radius, 2 * Radius, 2 * Radius);
+
     if(a_pixel__state.fillDraw) {
         a_platform__drawCircleFilled(X, Y, Radius);
     } else {
         a_platform__drawCircleOutline(X, Y, Radius);
     }
 }
+
+void a_draw_circleAntialiased(int X, int Y, int Radius)
+{
+    a_screen__dirtyAdd(X - Radius - 1,
+                       Y - Radius - 1,
+                       2 * Radius + 2,
+                       2 * Radius + 2);
+
+    a_platform__drawCircleAntialiased(X, Y, Radius);
+}
+
+void a_draw_ellipse(int X, int Y, int RadiusX, int RadiusY)
+{
+    if(RadiusX <= 0 || RadiusY <= 0) {
+        return;
+    }
+
+    a_screen__dirtyAdd(X - RadiusX, Y - RadiusY, 2 * RadiusX, 2 * RadiusY);
+
+    if(a_pixel__state.fillDraw) {
+        a_platform__drawEllipseFilled(X, Y, RadiusX, RadiusY);
+    } else {
+        a_platform__drawEllipseOutline(X, Y, RadiusX, RadiusY);
+    }
+}
+
+// Plots up to but not including X2, Y2, so triangle and polygon corners that
+// are shared by two edges are only blended once
+static void edgeDraw(int X1, int Y1, int X2, int Y2)
+{
+    const int dx = a_math_abs(X2 - X1);
+    const int dy = -a_math_abs(Y2 - Y1);
+
+    if(!a_screen_boxOnClip(
+            a_math_min(X1, X2), a_math_min(Y1, Y2), dx + 1, -dy + 1)) {
+
+        return;
+    }
+
+    const int xinc = X1 < X2 ? 1 : -1;
+    const int yinc = Y1 < Y2 ? 1 : -1;
+    int error = dx + dy;
+
+    AVectorInt points[A__EDGE_CHUNK];
+    unsigned num = 0;
+
+    while(X1 != X2 || Y1 != Y2) {
+        points[num++] = (AVectorInt){X1, Y1};
+
+        if(num == A__EDGE_CHUNK) {
+            a_platform__drawPixels(points, num);
+            num = 0;
+        }
+
+        const int error2 = 2 * error;
+
+        if(error2 >= dy) {
+            error += dy;
+            X1 += xinc;
+        }
+
+        if(error2 <= dx) {
+            error += dx;
+            Y1 += yinc;
+        }
+    }
+
+    if(num > 0) {
+        a_platform__drawPixels(points, num);
+    }
+}
+
+void a_draw_triangle(int X1, int Y1, int X2, int Y2, int X3, int Y3)
+{
+    const int minX = a_math_min(X1, a_math_min(X2, X3));
+    const int minY = a_math_min(Y1, a_math_min(Y2, Y3));
+    const int maxX = a_math_max(X1, a_math_max(X2, X3));
+    const int maxY = a_math_max(Y1, a_math_max(Y2, Y3));
+
+    a_screen__dirtyAdd(minX, minY, maxX - minX + 1, maxY - minY + 1);
+
+    if(!a_pixel__state.fillDraw) {
+        edgeDraw(X1, Y1, X2, Y2);
+        edgeDraw(X2, Y2, X3, Y3);
+        edgeDraw(X3, Y3, X1, Y1);
+
+        return;
+    }
+
+    // Platform expects vertices sorted top to bottom
+    if(Y2 < Y1) {
+        A__SWAP(X1, X2);
+        A__SWAP(Y1, Y2);
+    }
+
+    if(Y3 < Y1) {
+        A__SWAP(X1, X3);
+        A__SWAP(Y1, Y3);
+    }
+
+    if(Y3 < Y2) {
+        A__SWAP(X2, X3);
+        A__SWAP(Y2, Y3);
+    }
+
+    if(Y1 < Y3) {
+        a_platform__drawTriangleFilled(X1, Y1, X2, Y2, X3, Y3);
+    }
+}
+
+void a_draw_polygon(const AVectorInt* Vertices, unsigned NumVertices)
+{
+    if(NumVertices < 3) {
+        return;
+    }
+
+    // Convex polygon as a fan, the fill rule keeps shared edges from
+    // being drawn twice
+    if(a_pixel__state.fillDraw) {
+        for(unsigned v = 2; v < NumVertices; v++) {
+            a_draw_triangle(Vertices[0].x,
+                            Vertices[0].y,
+                            Vertices[v - 1].x,
+                            Vertices[v - 1].y,
+                            Vertices[v].x,
+                            Vertices[v].y);
+        }
+    } else {
+        dirtyAddPoints(Vertices, NumVertices);
+
+        for(unsigned v = 0; v < NumVertices; v++) {
+            const AVectorInt* next = &Vertices[(v + 1) % NumVertices];
+
+            edgeDraw(Vertices[v].x, Vertices[v].y, next->x, next->y);
+        }
+    }
+}
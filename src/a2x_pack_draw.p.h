@@ -20,10 +20,20 @@
 
 #include "a2x_system_includes.h"
 
+#include "a2x_pack_fix.p.h"
+
 extern void a_draw_fill(void);
 extern void a_draw_pixel(int X, int Y);
+extern void a_draw_pixels(const AVectorInt* Points, unsigned NumPoints);
 extern void a_draw_line(int X1, int Y1, int X2, int Y2);
+extern void a_draw_lines(const AVectorInt* Points, unsigned NumLines);
+extern void a_draw_lineAntialiased(int X1, int Y1, int X2, int Y2);
 extern void a_draw_hline(int X1, int X2, int Y);
 extern void a_draw_vline(int X, int Y1, int Y2);
 extern void a_draw_rectangle(int X, int Y, int Width, int Height);
+extern void a_draw_rectangles(const AVectorInt* Rectangles, unsigned NumRectangles);
 extern void a_draw_circle(int X, int Y, int Radius);
+extern void a_draw_circleAntialiased(int X, int Y, int Radius);
+extern void a_draw_ellipse(int X, int Y, int RadiusX, int RadiusY);
+extern void a_draw_triangle(int X1, int Y1, int X2, int Y2, int X3, int Y3);
+extern void a_draw_polygon(const AVectorInt* Vertices, unsigned NumVertices);
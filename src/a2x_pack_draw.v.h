@@ -19,3 +19,78 @@
 #pragma once
 
 #include "a2x_pack_draw.p.h"
+
+#define A__SWAP(A, B) { const int t = A; A = B; B = t; }
+
+// Triangle edge walked down one pixel row at a time, exact integer steps
+typedef struct {
+    int x; // first column whose pixel center is on or right of the edge
+    int stepX;
+    int64_t error, stepError, den;
+} ADrawEdge;
+
+static inline void a_draw__edgeInit(ADrawEdge* Edge, int X1, int Y1, int X2, int Y2, int Y)
+{
+    const int64_t dx = X2 - X1;
+    const int64_t dy = Y2 - Y1;
+
+    // Edge x at the center of row Y minus half a pixel is Num / Den
+    const int64_t num = (2 * (int64_t)X1 - 1) * dy + (2 * (int64_t)(Y - Y1) + 1) * dx;
+    const int64_t den = 2 * dy;
+
+    const int64_t x = num >= 0 ? (num + den - 1) / den : -(-num / den);
+    const int64_t stepX = dx >= 0 ? dx / dy : -((-dx + dy - 1) / dy);
+
+    Edge->x = (int)x;
+    Edge->stepX = (int)stepX;
+    Edge->error = num - x * den; // in (-Den, 0]
+    Edge->stepError = 2 * dx - stepX * den; // in [0, Den)
+    Edge->den = den;
+}
+
+static inline void a_draw__edgeStep(ADrawEdge* Edge)
+{
+    Edge->x += Edge->stepX;
+    Edge->error += Edge->stepError;
+
+    if(Edge->error > 0) {
+        Edge->x++;
+        Edge->error -= Edge->den;
+    }
+}
+
+// Ellipse quadrant walked down one pixel row at a time from its center.
+// A pixel is in when its center is, which is
+// (2x + 1)^2 * Ry^2 + (2y + 1)^2 * Rx^2 <= 4 * Rx^2 * Ry^2
+typedef struct {
+    int x; // last column in on row y, or -1
+    int y;
+    int64_t rx2, ry2, limit;
+} ADrawEllipseEdge;
+
+static inline void a_draw__ellipseStep(ADrawEllipseEdge* Ellipse)
+{
+    const int64_t dy = 2 * (int64_t)++Ellipse->y + 1;
+    const int64_t rowLimit = Ellipse->limit - dy * dy * Ellipse->rx2;
+
+    while(Ellipse->x >= 0) {
+        const int64_t dx = 2 * (int64_t)Ellipse->x + 1;
+
+        if(dx * dx * Ellipse->ry2 <= rowLimit) {
+            break;
+        }
+
+        Ellipse->x--;
+    }
+}
+
+static inline void a_draw__ellipseInit(ADrawEllipseEdge* Ellipse, int RadiusX, int RadiusY)
+{
+    Ellipse->x = RadiusX - 1;
+    Ellipse->y = -1;
+    Ellipse->rx2 = (int64_t)RadiusX * RadiusX;
+    Ellipse->ry2 = (int64_t)RadiusY * RadiusY;
+    Ellipse->limit = 4 * Ellipse->rx2 * Ellipse->ry2;
+
+    a_draw__ellipseStep(Ellipse);
+}
@@ -21,18 +21,19 @@
 #include "a2x_pack_ecs_collection.v.h"
 #include "a2x_pack_ecs_component.v.h"
 #include "a2x_pack_ecs_system.v.h"
+#include "a2x_pack_listintr.v.h"
 #include "a2x_pack_listit.v.h"
 #include "a2x_pack_mem.v.h"
 #include "a2x_pack_out.v.h"
 
-static AList* g_lists[A_ECS__NUM]; // Each entity is in exactly one of these
+static AListIntr g_lists[A_ECS__NUM]; // Each entity is in exactly one of these
 static bool g_deleting; // Set at uninit time to prevent using freed entities
 static ACollection* g_collection; // New entities are added to this collection
 
 void a_ecs__init(void)
 {
     for(int i = A_ECS__NUM; i--; ) {
-        g_lists[i] = a_list_new();
+        A_LISTINTR_INIT(&g_lists[i], AEntity, node);
     }
 }
 
@@ -41,7 +42,7 @@ void a_ecs__uninit(void)
     g_deleting = true;
 
     for(int i = A_ECS__NUM; i--; ) {
-        a_list_freeEx(g_lists[i], (AFree*)a_entity__free);
+        a_listintr_clearEx(&g_lists[i], (AFree*)a_entity__free);
     }
 
     a_template__uninit();
@@ -76,7 +77,7 @@ void a_ecs__tick(void)
     a_ecs__flushEntitiesFromSystems();
 
     // Check what systems the new entities match
-    A_LIST_ITERATE(g_lists[A_ECS__NEW], AEntity*, e) {
+    A_LISTINTR_ITERATE(&g_lists[A_ECS__NEW], AEntity*, e) {
         for(unsigned id = a_system__tableLen; id--; ) {
             ASystem* s = a_system__get((int)id, __func__);
 
@@ -89,11 +90,11 @@ void a_ecs__tick(void)
             }
         }
 
-        a_ecs__entityAddToList(e, A_ECS__RESTORE);
+        a_ecs__entityMoveToList(e, A_ECS__RESTORE);
     }
 
     // Add entities to the systems they match
-    A_LIST_ITERATE(g_lists[A_ECS__RESTORE], AEntity*, e) {
+    A_LISTINTR_ITERATE(&g_lists[A_ECS__RESTORE], AEntity*, e) {
         if(!A_FLAG_TEST_ANY(e->flags, A_ENTITY__ACTIVE_REMOVED)) {
             A_LIST_ITERATE(e->matchingSystemsActive, ASystem*, system) {
                 a_list_addLast(
@@ -106,48 +107,44 @@ void a_ecs__tick(void)
                 e->systemNodesEither, a_list_addLast(system->entities, e));
         }
 
-        a_ecs__entityAddToList(e, A_ECS__DEFAULT);
+        a_ecs__entityMoveToList(e, A_ECS__DEFAULT);
     }
 
-    a_list_clear(g_lists[A_ECS__NEW]);
-    a_list_clear(g_lists[A_ECS__RESTORE]);
-    a_list_clearEx(g_lists[A_ECS__REMOVED_FREE], (AFree*)a_entity__free);
+    a_listintr_clearEx(&g_lists[A_ECS__REMOVED_FREE], (AFree*)a_entity__free);
 }
 
 bool a_ecs__entityIsInList(const AEntity* Entity, AEcsListId List)
 {
-    return a_list__nodeGetList(Entity->node) == g_lists[List];
+    return Entity->list == (int)List;
 }
 
 void a_ecs__entityAddToList(AEntity* Entity, AEcsListId List)
 {
-    Entity->node = a_list_addLast(g_lists[List], Entity);
+    Entity->list = List;
+    a_listintr_addLast(&g_lists[List], Entity);
 }
 
 void a_ecs__entityMoveToList(AEntity* Entity, AEcsListId List)
 {
-    a_list_removeNode(Entity->node);
-    Entity->node = a_list_addLast(g_lists[List], Entity);
+    a_listintr_removeNode(&Entity->node);
+    a_ecs__entityAddToList(Entity, List);
 }
 
 void a_ecs__flushEntitiesFromSystems(void)
 {
-    A_LIST_ITERATE(g_lists[A_ECS__MUTED_QUEUE], AEntity*, e) {
+    A_LISTINTR_ITERATE(&g_lists[A_ECS__MUTED_QUEUE], AEntity*, e) {
         a_entity__removeFromAllSystems(e);
 
-        a_ecs__entityAddToList(e, A_ECS__DEFAULT);
+        a_ecs__entityMoveToList(e, A_ECS__DEFAULT);
     }
 
-    A_LIST_ITERATE(g_lists[A_ECS__REMOVED_QUEUE], AEntity*, e) {
+    A_LISTINTR_ITERATE(&g_lists[A_ECS__REMOVED_QUEUE], AEntity*, e) {
         a_entity__removeFromAllSystems(e);
 
         if(e->references == 0) {
-            a_ecs__entityAddToList(e, A_ECS__REMOVED_FREE);
+            a_ecs__entityMoveToList(e, A_ECS__REMOVED_FREE);
         } else {
-            a_ecs__entityAddToList(e, A_ECS__REMOVED_LIMBO);
+            a_ecs__entityMoveToList(e, A_ECS__REMOVED_LIMBO);
         }
     }
-
-    a_list_clear(g_lists[A_ECS__MUTED_QUEUE]);
-    a_list_clear(g_lists[A_ECS__REMOVED_QUEUE]);
 }
@@ -18,49 +18,49 @@
 
 #include "a2x_pack_ecs_collection.v.h"
 
-#include "a2x_pack_listit.v.h"
+#include "a2x_pack_listintr.v.h"
 #include "a2x_pack_mem.v.h"
 
 struct ACollection {
-    AList* entities; // list of AEntity
+    AListIntr entities; // list of AEntity
 };
 
 ACollection* a_collection_new(void)
 {
     ACollection* c = a_mem_malloc(sizeof(ACollection));
 
-    c->entities = a_list_new();
+    A_LISTINTR_INIT(&c->entities, AEntity, collectionNode);
 
     return c;
 }
 
 void a_collection_free(ACollection* Collection)
 {
-    a_list_freeEx(Collection->entities, (AFree*)a_entity_removeSet);
+    a_listintr_clearEx(&Collection->entities, (AFree*)a_entity_removeSet);
 
-    free(Collection);
+    a_mem_free(Collection);
 }
 
 void a_collection__add(ACollection* Collection, AEntity* Entity)
 {
-    Entity->collectionNode = a_list_addLast(Collection->entities, Entity);
+    a_listintr_addLast(&Collection->entities, Entity);
 }
 
 void a_collection_clear(ACollection* Collection)
 {
-    a_list_clearEx(Collection->entities, (AFree*)a_entity_removeSet);
+    a_listintr_clearEx(&Collection->entities, (AFree*)a_entity_removeSet);
 }
 
 void a_collection_muteInc(ACollection* Collection)
 {
-    A_LIST_ITERATE(Collection->entities, AEntity*, e) {
+    A_LISTINTR_ITERATE(&Collection->entities, AEntity*, e) {
         a_entity_muteInc(e);
     }
 }
 
 void a_collection_muteDec(ACollection* Collection)
 {
-    A_LIST_ITERATE(Collection->entities, AEntity*, e) {
+    A_LISTINTR_ITERATE(&Collection->entities, AEntity*, e) {
         a_entity_muteDec(e);
     }
 }
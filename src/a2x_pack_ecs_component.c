@@ -49,7 +49,7 @@ void a_component__init(unsigned NumComponents)
 void a_component__uninit(void)
 {
     a_strhash_free(g_components);
-    free(g_componentsTable);
+    a_mem_free(g_componentsTable);
 }
 
 int a_component__stringToIndex(const char* StringId)
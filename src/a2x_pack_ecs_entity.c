@@ -106,9 +106,8 @@ void a_entity__free(AEntity* Entity)
         a_out__message("a_entity__free(%s)", a_entity_idGet(Entity));
     }
 
-    if(Entity->collectionNode) {
-        a_list_removeNode(Entity->collectionNode);
-    }
+    a_listintr_removeNode(&Entity->node);
+    a_listintr_removeNode(&Entity->collectionNode);
 
     a_list_free(Entity->matchingSystemsActive);
     a_list_free(Entity->matchingSystemsRest);
@@ -126,7 +125,7 @@ void a_entity__free(AEntity* Entity)
             header->component->free(a_component__headerGetData(header));
         }
 
-        free(header);
+        a_mem_free(header);
     }
 
     if(Entity->parent) {
@@ -135,8 +134,8 @@ void a_entity__free(AEntity* Entity)
 
     a_bitfield_free(Entity->componentBits);
 
-    free(Entity->id);
-    free(Entity);
+    a_mem_free(Entity->id);
+    a_mem_free(Entity);
 }
 
 void a_entity_debugSet(AEntity* Entity, bool DebugOn)
@@ -264,10 +263,7 @@ void a_entity_removeSet(AEntity* Entity)
     A_FLAG_SET(Entity->flags, A_ENTITY__REMOVED);
     a_ecs__entityMoveToList(Entity, A_ECS__REMOVED_QUEUE);
 
-    if(Entity->collectionNode) {
-        a_list_removeNode(Entity->collectionNode);
-        Entity->collectionNode = NULL;
-    }
+    a_listintr_removeNode(&Entity->collectionNode);
 }
 
 bool a_entity_activeGet(const AEntity* Entity)
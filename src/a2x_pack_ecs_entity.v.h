@@ -24,6 +24,7 @@
 #include "a2x_pack_ecs_component.v.h"
 #include "a2x_pack_ecs_template.v.h"
 #include "a2x_pack_list.v.h"
+#include "a2x_pack_listintr.v.h"
 
 typedef enum {
     A_ENTITY__ACTIVE_REMOVED = A_FLAG_BIT(0), // kicked out by active system
@@ -37,8 +38,9 @@ struct AEntity {
     void* context; // global context
     const ATemplate* template; // template used to init this entity's components
     AEntity* parent; // manually associated parent entity
-    AListNode* node; // list node in one of AEcsListId
-    AListNode* collectionNode; // ACollection list nod
+    AListIntrNode node; // list node in one of AEcsListId
+    AListIntrNode collectionNode; // ACollection list node
+    int list; // the AEcsListId this entity is in
     AList* matchingSystemsActive; // list of ASystem
     AList* matchingSystemsRest; // list of ASystem
     AList* systemNodesActive; // list of nodes in active-only ASystem lists
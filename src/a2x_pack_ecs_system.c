@@ -44,7 +44,7 @@ void a_system__uninit(void)
         a_bitfield_free(g_systemsTable[s].componentBits);
     }
 
-    free(g_systemsTable);
+    a_mem_free(g_systemsTable);
 }
 
 ASystem* a_system__get(int System, const char* CallerFunction)
@@ -81,11 +81,11 @@ static void templateFree(ATemplate* Template)
                 component->dataFree(Template->data[c]);
             }
 
-            free(Template->data[c]);
+            a_mem_free(Template->data[c]);
         }
     }
 
-    free(Template);
+    a_mem_free(Template);
 }
 
 void a_template__init(void)
@@ -45,10 +45,20 @@ AFont* g_defaultFonts[A_FONT__ID_NUM];
 static AFontState g_state;
 static AList* g_stateStack;
 static char g_buffer[512];
+static AFontGlyph* g_glyph;
+static void* g_glyphContext;
+
+static void glyphBlit(const ASprite* Glyph, int X, int Y, void* Context)
+{
+    A_UNUSED(Context);
+
+    a_sprite_blit(Glyph, X, Y);
+}
 
 void a_font__init(void)
 {
     g_stateStack = a_list_new();
+    g_glyph = glyphBlit;
 
     APixel colors[A_FONT__ID_NUM] = {
         [A_FONT__ID_LIGHT_GRAY] = a_pixel_fromHex(0xaf9898),
@@ -75,7 +85,7 @@ void a_font__uninit(void)
         a_font_free(g_defaultFonts[f]);
     }
 
-    a_list_freeEx(g_stateStack, free);
+    a_list_freeEx(g_stateStack, a_mem_free);
 }
 
 static AFont* a_font__new(ASpriteFrames* Frames)
@@ -140,7 +150,7 @@ void a_font_free(AFont* Font)
 
     a_spriteframes_free(Font->frames, true);
 
-    free(Font);
+    a_mem_free(Font);
 }
 
 void a_font_push(void)
@@ -157,7 +167,7 @@ void a_font_pop(void)
     }
 
     g_state = *state;
-    free(state);
+    a_mem_free(state);
 }
 
 void a_font_reset(void)
@@ -231,6 +241,14 @@ void a_font_lineWrapSet(int Width)
     g_state.currentLineWidth = 0;
 }
 
+void a_font__layoutGet(AFontLayout* Layout)
+{
+    Layout->font = g_state.font;
+    Layout->align = g_state.align;
+    Layout->lineHeight = g_state.lineHeight;
+    Layout->wrapWidth = g_state.wrapWidth;
+}
+
 static int getWidth(const char* Text, ptrdiff_t Length)
 {
     int width = 0;
@@ -256,7 +274,7 @@ static void drawString(const char* Text, ptrdiff_t Length)
     for( ; Length--; Text++) {
         const ASprite* s = a_spriteframes_getByIndex(f, A__CHAR_INDEX(*Text));
 
-        a_sprite_blit(s, g_state.x, g_state.y);
+        g_glyph(s, g_state.x, g_state.y, g_glyphContext);
         g_state.x += s->w;
     }
 }
@@ -323,6 +341,17 @@ static void wrapString(const char* Text)
     drawString(lineStart, Text - lineStart);
 }
 
+void a_font__printEx(const char* Text, AFontGlyph* Glyph, void* Context)
+{
+    g_glyph = Glyph;
+    g_glyphContext = Context;
+
+    a_font_print(Text);
+
+    g_glyph = glyphBlit;
+    g_glyphContext = NULL;
+}
+
 void a_font_print(const char* Text)
 {
     if(g_state.wrapWidth > 0) {
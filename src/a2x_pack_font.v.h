@@ -32,7 +32,19 @@ typedef enum {
     A_FONT__ID_NUM
 } AFontId;
 
+typedef struct {
+    const AFont* font;
+    AFontAlign align;
+    int lineHeight;
+    int wrapWidth;
+} AFontLayout;
+
+typedef void AFontGlyph(const ASprite* Glyph, int X, int Y, void* Context);
+
 extern void a_font__init(void);
 extern void a_font__uninit(void);
 
 extern void a_font__fontSet(AFontId Font);
+
+extern void a_font__layoutGet(AFontLayout* Layout);
+extern void a_font__printEx(const char* Text, AFontGlyph* Glyph, void* Context);
@@ -74,8 +74,8 @@ void a_fps__init(void)
 
 void a_fps__uninit(void)
 {
-    free(g_history.drawFrameMs);
-    free(g_history.drawFrameMsMin);
+    a_mem_free(g_history.drawFrameMs);
+    a_mem_free(g_history.drawFrameMsMin);
 }
 
 void a_fps__reset(void)
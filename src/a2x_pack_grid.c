@@ -18,21 +18,25 @@
 
 #include "a2x_pack_grid.v.h"
 
-#include "a2x_pack_listit.v.h"
+#include "a2x_pack_listintr.v.h"
 #include "a2x_pack_math.v.h"
 #include "a2x_pack_mem.v.h"
 
+// An item is in at most 2x2 cells, and each of those has a different
+// (x & 1, y & 1) parity, which picks the item's node for that cell's list
+#define A_GRID__CELL_NODE(X, Y) ((((Y) & 1) << 1) | ((X) & 1))
+
 struct AGrid {
     int coordsShift; // right-shift item coords to get cell index
     int w, h; // width and height of grid in cells
-    AList*** cells; // AList*[h][w] of AGridItem
-    AList** cellsData; // AList*[h * w] of AGridItem
+    AListIntr** cells; // AListIntr[h][w] of AGridItem
+    AListIntr* cellsData; // AListIntr[h * w] of AGridItem
 };
 
 struct AGridItem {
     const AGrid* grid;
     void* context; // the game item that owns this AGridItem
-    AList* nodes; // list of AListNode from cells this item is in
+    AListIntrNode nodes[4]; // list nodes for the cells this item is in
     AFix x, y; // coords on the grid
 };
 
@@ -51,15 +55,18 @@ AGrid* a_grid_new(AFix Width, AFix Height, AFix MaxObjectDim)
     g->w = a_fix_toInt((Width + cellDim - 1) >> g->coordsShift);
     g->h = a_fix_toInt((Height + cellDim - 1) >> g->coordsShift);
 
-    g->cells = a_mem_malloc((unsigned)g->h * sizeof(AList**));
+    g->cells = a_mem_malloc((unsigned)g->h * sizeof(AListIntr*));
     g->cellsData = a_mem_malloc(
-                        (unsigned)g->h * (unsigned)g->w * sizeof(AList*));
+                        (unsigned)g->h * (unsigned)g->w * sizeof(AListIntr));
 
     for(int i = g->h; i--; ) {
         g->cells[i] = g->cellsData + i * g->w;
 
         for(int j = g->w; j--; ) {
-            g->cells[i][j] = a_list_new();
+            a_listintr_init(
+                &g->cells[i][j],
+                offsetof(AGridItem, nodes)
+                    + (unsigned)A_GRID__CELL_NODE(j, i) * sizeof(AListIntrNode));
         }
     }
 
@@ -74,29 +81,22 @@ void a_grid_free(AGrid* Grid)
 
     for(int i = Grid->h; i--; ) {
         for(int j = Grid->w; j--; ) {
-            A_LIST_ITERATE(Grid->cells[i][j], AGridItem*, i) {
-                a_list_free(i->nodes);
-                i->nodes = NULL; // In case grid is freed before the items
-            }
-
-            a_list_free(Grid->cells[i][j]);
+            // In case grid is freed before the items
+            a_listintr_clear(&Grid->cells[i][j]);
         }
     }
 
-    free(Grid->cells);
-    free(Grid->cellsData);
-    free(Grid);
+    a_mem_free(Grid->cells);
+    a_mem_free(Grid->cellsData);
+    a_mem_free(Grid);
 }
 
 AGridItem* a_griditem_new(const AGrid* Grid, void* Context)
 {
-    AGridItem* i = a_mem_malloc(sizeof(AGridItem));
+    AGridItem* i = a_mem_zalloc(sizeof(AGridItem));
 
     i->grid = Grid;
     i->context = Context;
-    i->nodes = a_list_new();
-    i->x = 0;
-    i->y = 0;
 
     return i;
 }
@@ -108,22 +108,25 @@ void a_griditem_free(AGridItem* Item)
     }
 
     // Remove item from any lists it is in
-    a_list_freeEx(Item->nodes, (AFree*)a_list_removeNode);
+    for(int n = 4; n--; ) {
+        a_listintr_removeNode(&Item->nodes[n]);
+    }
 
-    free(Item);
+    a_mem_free(Item);
 }
 
 void a_griditem_coordsSet(AGridItem* Item, AFix X, AFix Y)
 {
     const AGrid* grid = Item->grid;
-    AList* cellNodes = Item->nodes;
-    AList*** cells = grid->cells;
+    AListIntr** cells = grid->cells;
 
     Item->x = X;
     Item->y = Y;
 
     // remove item from all the cells it was previously in
-    a_list_clearEx(cellNodes, (AFree*)a_list_removeNode);
+    for(int n = 4; n--; ) {
+        a_listintr_removeNode(&Item->nodes[n]);
+    }
 
     // center cell coords
     int cellX = a_fix_toInt(Item->x >> grid->coordsShift);
@@ -156,7 +159,7 @@ void a_griditem_coordsSet(AGridItem* Item, AFix X, AFix Y)
     // add item to every cell in its surrounding perimeter
     for(int y = cellStartY; y <= cellEndY; y++) {
         for(int x = cellStartX; x <= cellEndX; x++) {
-            a_list_addFirst(cellNodes, a_list_addFirst(cells[y][x], Item));
+            a_listintr_addFirst(&cells[y][x], Item);
         }
     }
 }
@@ -166,7 +169,7 @@ void* a__griditem_contextGet(const AGridItem* Item)
     return Item->context;
 }
 
-AList* a__griditem_nearbyListGet(const AGridItem* Item)
+AListIntr* a__griditem_nearbyListGet(const AGridItem* Item)
 {
     const AGrid* grid = Item->grid;
 
@@ -175,5 +178,5 @@ AList* a__griditem_nearbyListGet(const AGridItem* Item)
     int cellY = a_math_clamp(
                     a_fix_toInt(Item->y >> grid->coordsShift), 0, grid->h - 1);
 
-    return grid->cells[cellY][cellX];
+    return &grid->cells[cellY][cellX];
 }
@@ -24,7 +24,7 @@ typedef struct AGrid AGrid;
 typedef struct AGridItem AGridItem;
 
 #include "a2x_pack_fix.p.h"
-#include "a2x_pack_list.p.h"
+#include "a2x_pack_listintr.p.h"
 
 extern AGrid* a_grid_new(AFix Width, AFix Height, AFix MaxObjectDim);
 extern void a_grid_free(AGrid* Grid);
@@ -35,12 +35,13 @@ extern void a_griditem_free(AGridItem* Item);
 extern void a_griditem_coordsSet(AGridItem* Item, AFix X, AFix Y);
 
 extern void* a__griditem_contextGet(const AGridItem* Item);
-extern AList* a__griditem_nearbyListGet(const AGridItem* Item);
+extern AListIntr* a__griditem_nearbyListGet(const AGridItem* Item);
 
 #define A_GRID_ITERATE(GridItem, ContextPtrType, ContextVarName)              \
     for(const AGridItem* a__gi = GridItem; a__gi; a__gi = NULL)               \
-        A_LIST_FILTER(a__griditem_nearbyListGet(a__gi),                       \
-                      const AGridItem*, a__i,                                 \
-                      a__i != a__gi)                                          \
+        A_LISTINTR_ITERATE(a__griditem_nearbyListGet(a__gi),                  \
+                           const AGridItem*, a__i)                            \
+            if(a__i == a__gi) continue;                                       \
+            else                                                              \
             for(ContextPtrType ContextVarName = a__griditem_contextGet(a__i); \
                 a__i != NULL; a__i = NULL)
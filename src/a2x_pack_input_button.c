@@ -19,6 +19,7 @@
 #include "a2x_pack_input_button.v.h"
 
 #include "a2x_pack_input.v.h"
+#include "a2x_pack_listintr.v.h"
 #include "a2x_pack_listit.v.h"
 #include "a2x_pack_mem.v.h"
 #include "a2x_pack_out.v.h"
@@ -27,7 +28,7 @@
 
 struct AButton {
     AInputUserHeader header;
-    AListNode* listNode;
+    AListIntrNode listNode;
     AList* combos; // List of lists of APlatformInputButton, each a button combo
     AList* currentCombo;
     ATimer* autoRepeat;
@@ -72,16 +73,16 @@ const char* a__keyNames[A__KEY_ID(A_KEY_NUM)] = {
     [A__KEY_ID(A_KEY_F12)] = "F12",
 };
 
-static AList* g_buttons; // list of AButton
+static AListIntr g_buttons; // list of AButton
 
 void a_input_button__init(void)
 {
-    g_buttons = a_list_new();
+    A_LISTINTR_INIT(&g_buttons, AButton, listNode);
 }
 
 void a_input_button__uninit(void)
 {
-    a_list_free(g_buttons);
+    a_listintr_clear(&g_buttons);
 }
 
 AButton* a_button_new(void)
@@ -90,7 +91,8 @@ AButton* a_button_new(void)
 
     a_input__userHeaderInit(&b->header);
 
-    b->listNode = a_list_addLast(g_buttons, b);
+    a_listintr_addLast(&g_buttons, b);
+
     b->combos = a_list_new();
     b->currentCombo = NULL;
     b->autoRepeat = NULL;
@@ -105,7 +107,8 @@ AButton* a_button_dup(const AButton* Button)
 {
     AButton* b = a_mem_dup(Button, sizeof(AButton));
 
-    b->listNode = a_list_addLast(g_buttons, b);
+    a_listintr_addLast(&g_buttons, b);
+
     b->autoRepeat = NULL;
     b->isClone = true;
     b->waitForRelease = false;
@@ -120,7 +123,7 @@ void a_button_free(AButton* Button)
         return;
     }
 
-    a_list_removeNode(Button->listNode);
+    a_listintr_removeNode(&Button->listNode);
 
     if(!Button->isClone) {
         a_list_freeEx(Button->combos, (AFree*)a_list_free);
@@ -129,7 +132,7 @@ void a_button_free(AButton* Button)
 
     a_timer_free(Button->autoRepeat);
 
-    free(Button);
+    a_mem_free(Button);
 }
 
 void a_button_bind(AButton* Button, int Id)
@@ -208,7 +211,7 @@ void a_button_pressClear(AButton* Button)
 
 void a_input_button__tick(void)
 {
-    A_LIST_ITERATE(g_buttons, AButton*, b) {
+    A_LISTINTR_ITERATE(&g_buttons, AButton*, b) {
         bool pressed = false;
 
         A_LIST_ITERATE(b->header.platformInputs, APlatformInputButton*, pb) {
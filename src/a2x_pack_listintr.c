@@ -0,0 +1,140 @@
+/*
+    Copyright 2019 Alex Margarit <alex@alxm.org>
+    This file is part of a2x, a C video game framework.
+
+    This program is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    This program is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with this program.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#include "a2x_pack_listintr.v.h"
+
+static inline AListIntrNode* itemToNode(const AListIntr* List, void* Item)
+{
+    return (AListIntrNode*)(void*)((uint8_t*)Item + List->nodeOffset);
+}
+
+static inline void* nodeToItem(const AListIntr* List, AListIntrNode* Node)
+{
+    return (uint8_t*)Node - List->nodeOffset;
+}
+
+static inline void unlinkNode(AListIntrNode* Node)
+{
+    Node->prev->next = Node->next;
+    Node->next->prev = Node->prev;
+
+    Node->next = NULL;
+    Node->prev = NULL;
+}
+
+void a_listintr_init(AListIntr* List, size_t NodeOffset)
+{
+    List->sentinel.next = &List->sentinel;
+    List->sentinel.prev = &List->sentinel;
+    List->nodeOffset = NodeOffset;
+}
+
+void a_listintr_addFirst(AListIntr* List, void* Item)
+{
+    AListIntrNode* n = itemToNode(List, Item);
+
+    n->next = List->sentinel.next;
+    n->prev = &List->sentinel;
+
+    n->prev->next = n;
+    n->next->prev = n;
+}
+
+void a_listintr_addLast(AListIntr* List, void* Item)
+{
+    AListIntrNode* n = itemToNode(List, Item);
+
+    n->next = &List->sentinel;
+    n->prev = List->sentinel.prev;
+
+    n->prev->next = n;
+    n->next->prev = n;
+}
+
+void* a_listintr_getFirst(const AListIntr* List)
+{
+    AListIntrNode* n = List->sentinel.next;
+
+    if(n == &List->sentinel) {
+        return NULL;
+    }
+
+    return nodeToItem(List, n);
+}
+
+void* a_listintr_getLast(const AListIntr* List)
+{
+    AListIntrNode* n = List->sentinel.prev;
+
+    if(n == &List->sentinel) {
+        return NULL;
+    }
+
+    return nodeToItem(List, n);
+}
+
+void a_listintr_removeItem(const AListIntr* List, void* Item)
+{
+    a_listintr_removeNode(itemToNode(List, Item));
+}
+
+void* a_listintr_removeFirst(AListIntr* List)
+{
+    AListIntrNode* n = List->sentinel.next;
+
+    if(n == &List->sentinel) {
+        return NULL;
+    }
+
+    unlinkNode(n);
+
+    return nodeToItem(List, n);
+}
+
+void a_listintr_removeNode(AListIntrNode* Node)
+{
+    if(Node->next) {
+        unlinkNode(Node);
+    }
+}
+
+void a_listintr_clear(AListIntr* List)
+{
+    a_listintr_clearEx(List, NULL);
+}
+
+void a_listintr_clearEx(AListIntr* List, AFree* Free)
+{
+    // Unlink each item before its callback, so the callback may free it
+    // or move it to another list
+    for(void* item; (item = a_listintr_removeFirst(List)) != NULL; ) {
+        if(Free) {
+            Free(item);
+        }
+    }
+}
+
+bool a_listintr_isEmpty(const AListIntr* List)
+{
+    return List->sentinel.next == &List->sentinel;
+}
+
+bool a_listintr_nodeIsLinked(const AListIntrNode* Node)
+{
+    return Node->next != NULL;
+}
@@ -0,0 +1,97 @@
+/*
+    Copyright 2019 Alex Margarit <alex@alxm.org>
+    This file is part of a2x, a C video game framework.
+
+    This program is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    This program is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with this program.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#pragma once
+
+#include "a2x_system_includes.h"
+
+typedef struct AListIntr AListIntr;
+typedef struct AListIntrNode AListIntrNode;
+typedef struct AListIntrIt AListIntrIt;
+
+struct AListIntrNode {
+    AListIntrNode* next; // NULL if not in a list
+    AListIntrNode* prev;
+};
+
+struct AListIntr {
+    AListIntrNode sentinel;
+    size_t nodeOffset; // offset of the AListIntrNode field in items
+};
+
+struct AListIntrIt {
+    const AListIntrNode* sentinelNode;
+    AListIntrNode* nextNode;
+    size_t nodeOffset;
+};
+
+#define A_LISTINTR_INIT(List, ItemType, NodeField) \
+    a_listintr_init(List, offsetof(ItemType, NodeField))
+
+extern void a_listintr_init(AListIntr* List, size_t NodeOffset);
+
+// Items must not already be in a list
+extern void a_listintr_addFirst(AListIntr* List, void* Item);
+extern void a_listintr_addLast(AListIntr* List, void* Item);
+
+extern void* a_listintr_getFirst(const AListIntr* List);
+extern void* a_listintr_getLast(const AListIntr* List);
+
+extern void a_listintr_removeItem(const AListIntr* List, void* Item);
+extern void* a_listintr_removeFirst(AListIntr* List);
+extern void a_listintr_removeNode(AListIntrNode* Node);
+
+extern void a_listintr_clear(AListIntr* List);
+extern void a_listintr_clearEx(AListIntr* List, AFree* Free);
+
+extern bool a_listintr_isEmpty(const AListIntr* List);
+extern bool a_listintr_nodeIsLinked(const AListIntrNode* Node);
+
+static inline AListIntrIt a__listintrit_new(const AListIntr* List)
+{
+    AListIntrIt it;
+
+    it.sentinelNode = &List->sentinel;
+    it.nextNode = List->sentinel.next;
+    it.nodeOffset = List->nodeOffset;
+
+    return it;
+}
+
+static inline bool a__listintrit_getNext(AListIntrIt* Iterator, void* UserPtrAddress)
+{
+    AListIntrNode* n = Iterator->nextNode;
+
+    if(n == Iterator->sentinelNode) {
+        return false;
+    }
+
+    // Save next node first, so the current item can unlink itself. The saved
+    // node is not checked again, so it must stay in the list until reached
+    Iterator->nextNode = n->next;
+    *(void**)UserPtrAddress = (uint8_t*)n - Iterator->nodeOffset;
+
+    return true;
+}
+
+// The loop body may unlink, move, or free the current item only
+#define A_LISTINTR_ITERATE(List, PtrType, Name)                          \
+    for(AListIntrIt a__lit = a__listintrit_new(List);                    \
+        a__lit.sentinelNode != NULL;                                     \
+        a__lit.sentinelNode = NULL)                                      \
+        for(PtrType Name; a__listintrit_getNext(&a__lit, (void*)&Name); )
@@ -36,6 +36,7 @@
 #include "a2x_pack_font.v.h"
 #include "a2x_pack_fps.v.h"
 #include "a2x_pack_input.v.h"
+#include "a2x_pack_mem.v.h"
 #include "a2x_pack_out.v.h"
 #include "a2x_pack_pixel.v.h"
 #include "a2x_pack_random.v.h"
@@ -69,6 +70,10 @@ static void a__atexit(void)
     a_block__uninit();
     a_embed__uninit();
 
+    #if A_CONFIG_BUILD_DEBUG_MEM
+        a_mem__uninit();
+    #endif
+
     #if A_CONFIG_SYSTEM_GP2X || A_CONFIG_SYSTEM_WIZ || A_CONFIG_SYSTEM_CAANOO
         #if A_CONFIG_SYSTEM_GP2X_MENU
             chdir("/usr/gp2x");
@@ -19,7 +19,366 @@
 #include "a2x_pack_mem.v.h"
 
 #include "a2x_pack_main.v.h"
+#include "a2x_pack_out.v.h"
 
+#if A_CONFIG_BUILD_DEBUG_MEM
+#define A_MEM__SITES_NUM 1024
+#define A_MEM__TABLE_SIZE_MIN 1024
+
+typedef struct {
+    const char* file; // NULL if unused
+    int line;
+    size_t bytesLive;
+    unsigned numLive;
+    unsigned numTotal;
+} AMemSite;
+
+typedef struct {
+    const void* buffer; // NULL if unused
+    size_t size;
+    AMemSite* site;
+} AMemEntry;
+
+static AMemSite g_sites[A_MEM__SITES_NUM]; // last site is the overflow site
+static AMemStats g_stats;
+
+static struct {
+    AMemEntry* entries;
+    size_t capacity; // power of 2
+    size_t num;
+} g_table;
+
+static unsigned g_frameAllocs;
+static size_t g_frameBytes;
+
+static inline size_t hashPtr(const void* Buffer)
+{
+    return (size_t)(((uintptr_t)Buffer >> 3) * 2654435761u);
+}
+
+static AMemSite* siteGet(const char* File, int Line)
+{
+    size_t i = (size_t)(((uintptr_t)File >> 2) ^ (unsigned)Line * 2654435761u);
+
+    for(size_t n = A_MEM__SITES_NUM - 1; n--; i++) {
+        AMemSite* s = &g_sites[i % (A_MEM__SITES_NUM - 1)];
+
+        if(s->file == NULL) {
+            s->file = File;
+            s->line = Line;
+
+            return s;
+        }
+
+        if(s->file == File && s->line == Line) {
+            return s;
+        }
+    }
+
+    AMemSite* s = &g_sites[A_MEM__SITES_NUM - 1];
+
+    s->file = "?";
+
+    return s;
+}
+
+static void entryRemove(size_t Index)
+{
+    const size_t mask = g_table.capacity - 1;
+    size_t hole = Index;
+
+    // Backward-shift the rest of the probe run, so lookups need no tombstones
+    for(size_t i = (Index + 1) & mask;
+        g_table.entries[i].buffer != NULL;
+        i = (i + 1) & mask) {
+
+        size_t home = hashPtr(g_table.entries[i].buffer) & mask;
+
+        if(((i - home) & mask) >= ((i - hole) & mask)) {
+            g_table.entries[hole] = g_table.entries[i];
+            hole = i;
+        }
+    }
+
+    g_table.entries[hole].buffer = NULL;
+    g_table.num--;
+}
+
+static void entryForget(AMemEntry* Entry)
+{
+    Entry->site->bytesLive -= Entry->size;
+    Entry->site->numLive--;
+
+    g_stats.bytesLive -= Entry->size;
+    g_stats.numLive--;
+}
+
+static size_t entryFind(const void* Buffer)
+{
+    if(g_table.capacity == 0) {
+        return SIZE_MAX;
+    }
+
+    const size_t mask = g_table.capacity - 1;
+
+    for(size_t i = hashPtr(Buffer) & mask;
+        g_table.entries[i].buffer != NULL;
+        i = (i + 1) & mask) {
+
+        if(g_table.entries[i].buffer == Buffer) {
+            return i;
+        }
+    }
+
+    return SIZE_MAX;
+}
+
+static void entryInsert(const void* Buffer, size_t Size, AMemSite* Site)
+{
+    // Address was freed with plain free() and reused, drop the stale entry
+    size_t stale = entryFind(Buffer);
+
+    if(stale != SIZE_MAX) {
+        entryForget(&g_table.entries[stale]);
+        entryRemove(stale);
+    }
+
+    if((g_table.num + 1) * 2 > g_table.capacity) {
+        AMemEntry* oldEntries = g_table.entries;
+        size_t oldCapacity = g_table.capacity;
+
+        g_table.capacity = oldCapacity == 0
+                            ? A_MEM__TABLE_SIZE_MIN : oldCapacity * 2;
+        g_table.entries = calloc(g_table.capacity, sizeof(AMemEntry));
+
+        if(g_table.entries == NULL) {
+            A__FATAL("calloc(%u, %u) failed",
+                     g_table.capacity,
+                     sizeof(AMemEntry));
+        }
+
+        const size_t mask = g_table.capacity - 1;
+
+        for(size_t e = 0; e < oldCapacity; e++) {
+            if(oldEntries[e].buffer == NULL) {
+                continue;
+            }
+
+            size_t i = hashPtr(oldEntries[e].buffer) & mask;
+
+            while(g_table.entries[i].buffer != NULL) {
+                i = (i + 1) & mask;
+            }
+
+            g_table.entries[i] = oldEntries[e];
+        }
+
+        free(oldEntries);
+    }
+
+    const size_t mask = g_table.capacity - 1;
+    size_t i = hashPtr(Buffer) & mask;
+
+    while(g_table.entries[i].buffer != NULL) {
+        i = (i + 1) & mask;
+    }
+
+    g_table.entries[i].buffer = Buffer;
+    g_table.entries[i].size = Size;
+    g_table.entries[i].site = Site;
+    g_table.num++;
+
+    Site->bytesLive += Size;
+    Site->numLive++;
+    Site->numTotal++;
+
+    g_stats.bytesLive += Size;
+    g_stats.numLive++;
+    g_stats.numTotal++;
+
+    if(g_stats.bytesLive > g_stats.bytesPeak) {
+        g_stats.bytesPeak = g_stats.bytesLive;
+    }
+
+    g_frameAllocs++;
+    g_frameBytes += Size;
+}
+
+void* a_mem__malloc(size_t Size, const char* File, int Line)
+{
+    void* ptr = malloc(Size);
+
+    if(ptr == NULL) {
+        A__FATAL("malloc(%u) failed at %s:%d", Size, File, Line);
+    }
+
+    entryInsert(ptr, Size, siteGet(File, Line));
+
+    return ptr;
+}
+
+void* a_mem__zalloc(size_t Size, const char* File, int Line)
+{
+    void* ptr = calloc(1, Size);
+
+    if(ptr == NULL) {
+        A__FATAL("calloc(1, %u) failed at %s:%d", Size, File, Line);
+    }
+
+    entryInsert(ptr, Size, siteGet(File, Line));
+
+    return ptr;
+}
+
+void* a_mem__dup(const void* Buffer, size_t Size, const char* File, int Line)
+{
+    void* copy = a_mem__malloc(Size, File, Line);
+
+    memcpy(copy, Buffer, Size);
+
+    return copy;
+}
+
+void a_mem_free(void* Buffer)
+{
+    if(Buffer == NULL) {
+        return;
+    }
+
+    size_t i = entryFind(Buffer);
+
+    if(i != SIZE_MAX) {
+        entryForget(&g_table.entries[i]);
+        entryRemove(i);
+    }
+
+    free(Buffer);
+}
+
+void a_mem__uninit(void)
+{
+    a_out__message("a_mem: %u allocations, %u bytes peak",
+                   g_stats.numTotal,
+                   g_stats.bytesPeak);
+
+    if(g_stats.numLive > 0) {
+        a_out__warning("a_mem: %u bytes in %u allocations not freed",
+                       g_stats.bytesLive,
+                       g_stats.numLive);
+
+        for(int s = 0; s < A_MEM__SITES_NUM; s++) {
+            const AMemSite* site = &g_sites[s];
+
+            if(site->numLive > 0) {
+                a_out__warning("  %s:%d - %u bytes in %u/%u allocations",
+                               site->file,
+                               site->line,
+                               site->bytesLive,
+                               site->numLive,
+                               site->numTotal);
+            }
+        }
+    }
+
+    free(g_table.entries);
+    g_table.entries = NULL;
+    g_table.capacity = 0;
+    g_table.num = 0;
+}
+
+void a_mem__frame(void)
+{
+    g_stats.frameAllocs = g_frameAllocs;
+    g_stats.frameBytes = g_frameBytes;
+
+    if(g_frameAllocs > g_stats.frameAllocsMax) {
+        g_stats.frameAllocsMax = g_frameAllocs;
+    }
+
+    g_frameAllocs = 0;
+    g_frameBytes = 0;
+}
+
+const AMemStats* a_mem__statsGet(void)
+{
+    return &g_stats;
+}
+
+static void subsystemNameGet(const char* File, char* Name, size_t Size)
+{
+    const char* base = strrchr(File, '/');
+
+    base = base ? base + 1 : File;
+
+    if(strncmp(base, "a2x_pack_", 9) == 0) {
+        base += 9;
+    }
+
+    size_t len = strcspn(base, "_.");
+
+    if(len >= Size) {
+        len = Size - 1;
+    }
+
+    memcpy(Name, base, len);
+    Name[len] = '\0';
+}
+
+unsigned a_mem__subsystemsGet(AMemSubsystem* Buffer, unsigned Num)
+{
+    static AMemSubsystem subs[64];
+    unsigned subsNum = 0;
+
+    for(int s = 0; s < A_MEM__SITES_NUM; s++) {
+        const AMemSite* site = &g_sites[s];
+
+        if(site->numLive == 0) {
+            continue;
+        }
+
+        char name[sizeof(subs[0].name)];
+        unsigned i;
+
+        subsystemNameGet(site->file, name, sizeof(name));
+
+        for(i = 0; i < subsNum; i++) {
+            if(strcmp(subs[i].name, name) == 0) {
+                break;
+            }
+        }
+
+        if(i == subsNum) {
+            if(subsNum == A_ARRAY_LEN(subs)) {
+                continue;
+            }
+
+            memcpy(subs[i].name, name, sizeof(name));
+            subs[i].bytesLive = 0;
+            subs[i].numLive = 0;
+            subsNum++;
+        }
+
+        subs[i].bytesLive += site->bytesLive;
+        subs[i].numLive += site->numLive;
+    }
+
+    // Partial selection sort, largest live bytes first
+    for(unsigned i = 0; i < Num && i < subsNum; i++) {
+        unsigned max = i;
+
+        for(unsigned j = i + 1; j < subsNum; j++) {
+            if(subs[j].bytesLive > subs[max].bytesLive) {
+                max = j;
+            }
+        }
+
+        Buffer[i] = subs[max];
+        subs[max] = subs[i];
+    }
+
+    return Num < subsNum ? Num : subsNum;
+}
+#else // !A_CONFIG_BUILD_DEBUG_MEM
 void* a_mem_malloc(size_t Size)
 {
     void* ptr = malloc(Size);
@@ -54,3 +413,9 @@ void* a_mem_dup(const void* Buffer, size_t Size)
 
     return copy;
 }
+
+void a_mem_free(void* Buffer)
+{
+    free(Buffer);
+}
+#endif // !A_CONFIG_BUILD_DEBUG_MEM
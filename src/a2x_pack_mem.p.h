@@ -20,7 +20,19 @@
 
 #include "a2x_system_includes.h"
 
-extern void* a_mem_malloc(size_t Size);
-extern void* a_mem_zalloc(size_t Size);
+#if A_CONFIG_BUILD_DEBUG_MEM
+    #define a_mem_malloc(Size) a_mem__malloc(Size, __FILE__, __LINE__)
+    #define a_mem_zalloc(Size) a_mem__zalloc(Size, __FILE__, __LINE__)
+    #define a_mem_dup(Buffer, Size) a_mem__dup(Buffer, Size, __FILE__, __LINE__)
 
-extern void* a_mem_dup(const void* Buffer, size_t Size);
+    extern void* a_mem__malloc(size_t Size, const char* File, int Line);
+    extern void* a_mem__zalloc(size_t Size, const char* File, int Line);
+    extern void* a_mem__dup(const void* Buffer, size_t Size, const char* File, int Line);
+#else
+    extern void* a_mem_malloc(size_t Size);
+    extern void* a_mem_zalloc(size_t Size);
+
+    extern void* a_mem_dup(const void* Buffer, size_t Size);
+#endif
+
+extern void a_mem_free(void* Buffer);
@@ -19,3 +19,28 @@
 #pragma once
 
 #include "a2x_pack_mem.p.h"
+
+#if A_CONFIG_BUILD_DEBUG_MEM
+    typedef struct {
+        size_t bytesLive;
+        size_t bytesPeak;
+        unsigned numLive;
+        unsigned numTotal;
+        unsigned frameAllocs; // allocations made during the last frame
+        unsigned frameAllocsMax;
+        size_t frameBytes;
+    } AMemStats;
+
+    typedef struct {
+        char name[16];
+        size_t bytesLive;
+        unsigned numLive;
+    } AMemSubsystem;
+
+    extern void a_mem__uninit(void);
+
+    extern void a_mem__frame(void);
+
+    extern const AMemStats* a_mem__statsGet(void);
+    extern unsigned a_mem__subsystemsGet(AMemSubsystem* Buffer, unsigned Num);
+#endif
@@ -0,0 +1,188 @@
+/*
+    Copyright 2019 Alex Margarit <alex@alxm.org>
+    This file is part of a2x, a C video game framework.
+
+    This program is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    This program is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with this program.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#include "a2x_pack_palette.v.h"
+
+#include "a2x_pack_main.v.h"
+#include "a2x_pack_mem.v.h"
+#include "a2x_pack_platform_software_tiles.v.h"
+#include "a2x_pack_sprite.v.h"
+
+#define A__PALETTE_HASH_BITS 9
+#define A__PALETTE_HASH_SIZE (1 << A__PALETTE_HASH_BITS)
+
+// Open-addressing map of colors to palette indices, 0 marks empty slots
+typedef struct {
+    APixel colors[A__PALETTE_HASH_SIZE];
+    uint8_t indices[A__PALETTE_HASH_SIZE];
+} APaletteHash;
+
+static unsigned hashSlot(const APaletteHash* Hash, APixel Color)
+{
+    unsigned slot = ((uint32_t)Color * 2654435761u)
+                        >> (32 - A__PALETTE_HASH_BITS);
+
+    while(Hash->indices[slot] != 0 && Hash->colors[slot] != Color) {
+        slot = (slot + 1) & (A__PALETTE_HASH_SIZE - 1);
+    }
+
+    return slot;
+}
+
+static void hashFromPalette(APaletteHash* Hash, const APalette* Palette)
+{
+    memset(Hash->indices, 0, sizeof(Hash->indices));
+
+    for(unsigned i = 1; i < Palette->num; i++) {
+        unsigned slot = hashSlot(Hash, Palette->colors[i]);
+
+        if(Hash->indices[slot] == 0) {
+            Hash->colors[slot] = Palette->colors[i];
+            Hash->indices[slot] = (uint8_t)i;
+        }
+    }
+}
+
+APalette* a_palette_new(void)
+{
+    APalette* p = a_mem_malloc(sizeof(APalette));
+
+    p->num = 1;
+
+    for(int i = A_PALETTE_SIZE; i--; ) {
+        p->colors[i] = a_sprite__colorKey;
+    }
+
+    return p;
+}
+
+APalette* a_palette_newFromSprite(const ASprite* Sprite)
+{
+    if(Sprite->palette) {
+        return a_palette_dup(Sprite->palette);
+    }
+
+    APalette* p = a_palette_new();
+    APaletteHash* hash = a_mem_zalloc(sizeof(APaletteHash));
+    const APixel* pixels = Sprite->pixels;
+
+    for(int i = Sprite->w * Sprite->h; i--; pixels++) {
+        if(*pixels == a_sprite__colorKey) {
+            continue;
+        }
+
+        unsigned slot = hashSlot(hash, *pixels);
+
+        if(hash->indices[slot] != 0) {
+            continue;
+        }
+
+        if(p->num == A_PALETTE_SIZE) {
+            A__FATAL("a_palette_newFromSprite(%s): More than %d colors",
+                     A_SPRITE__NAME(Sprite),
+                     A_PALETTE_SIZE - 1);
+        }
+
+        hash->colors[slot] = *pixels;
+        hash->indices[slot] = (uint8_t)p->num;
+        p->colors[p->num++] = *pixels;
+    }
+
+    a_mem_free(hash);
+
+    return p;
+}
+
+APalette* a_palette_dup(const APalette* Palette)
+{
+    return a_mem_dup(Palette, sizeof(APalette));
+}
+
+void a_palette_free(APalette* Palette)
+{
+    if(Palette == NULL) {
+        return;
+    }
+
+    #if A__TILES
+        a_platform_software_tiles__flush();
+    #endif
+
+    a_mem_free(Palette);
+}
+
+unsigned a_palette_sizeGet(const APalette* Palette)
+{
+    return Palette->num;
+}
+
+APixel a_palette_colorGet(const APalette* Palette, unsigned Index)
+{
+    if(Index >= A_PALETTE_SIZE) {
+        A__FATAL("a_palette_colorGet(%u): Invalid index", Index);
+    }
+
+    return Palette->colors[Index];
+}
+
+void a_palette_colorSet(APalette* Palette, unsigned Index, APixel Color)
+{
+    if(Index == 0 || Index >= A_PALETTE_SIZE) {
+        A__FATAL("a_palette_colorSet(%u): Invalid index", Index);
+    }
+
+    #if A__TILES
+        a_platform_software_tiles__flush();
+    #endif
+
+    Palette->colors[Index] = Color;
+
+    if(Index >= Palette->num) {
+        Palette->num = Index + 1;
+    }
+}
+
+uint8_t* a_palette__indicesNew(const APalette* Palette, const ASprite* Sprite)
+{
+    APaletteHash* hash = a_mem_malloc(sizeof(APaletteHash));
+    hashFromPalette(hash, Palette);
+
+    const APixel* pixels = Sprite->pixels;
+    uint8_t* indices = a_mem_malloc((size_t)(Sprite->w * Sprite->h));
+
+    for(int i = 0; i < Sprite->w * Sprite->h; i++) {
+        if(pixels[i] == a_sprite__colorKey) {
+            indices[i] = 0;
+            continue;
+        }
+
+        unsigned slot = hashSlot(hash, pixels[i]);
+
+        if(hash->indices[slot] == 0) {
+            A__FATAL("a_palette__indicesNew(%s): Color 0x%x not in palette",
+                     A_SPRITE__NAME(Sprite),
+                     (unsigned)pixels[i]);
+        }
+
+        indices[i] = hash->indices[slot];
+    }
+
+    a_mem_free(hash);
+
+    return indices;
+}
@@ -0,0 +1,38 @@
+/*
+    Copyright 2019 Alex Margarit <alex@alxm.org>
+    This file is part of a2x, a C video game framework.
+
+    This program is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    This program is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with this program.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#pragma once
+
+#include "a2x_system_includes.h"
+
+typedef struct APalette APalette;
+
+#include "a2x_pack_pixel.p.h"
+#include "a2x_pack_sprite.p.h"
+
+#define A_PALETTE_SIZE 256
+
+extern APalette* a_palette_new(void);
+extern APalette* a_palette_newFromSprite(const ASprite* Sprite);
+extern APalette* a_palette_dup(const APalette* Palette);
+extern void a_palette_free(APalette* Palette);
+
+extern unsigned a_palette_sizeGet(const APalette* Palette);
+
+extern APixel a_palette_colorGet(const APalette* Palette, unsigned Index);
+extern void a_palette_colorSet(APalette* Palette, unsigned Index, APixel Color);
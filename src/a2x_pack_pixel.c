@@ -21,22 +21,27 @@
 #include "a2x_pack_list.v.h"
 #include "a2x_pack_main.v.h"
 #include "a2x_pack_mem.v.h"
+#include "a2x_pack_pixel_simd.v.h"
 #include "a2x_pack_platform.v.h"
 #include "a2x_pack_platform_software_blit.v.h"
 #include "a2x_pack_platform_software_draw.v.h"
 
-APixelState a_pixel__state;
+A__THREAD_LOCAL APixelState a_pixel__state;
 static AList* g_stateStack;
 
 void a_pixel__init(void)
 {
     g_stateStack = a_list_new();
     a_pixel_reset();
+
+    #if A__PIXEL_PACKED
+        a_pixel__packedInit();
+    #endif
 }
 
 void a_pixel__uninit(void)
 {
-    a_list_freeEx(g_stateStack, free);
+    a_list_freeEx(g_stateStack, a_mem_free);
 }
 
 void a_pixel_push(void)
@@ -53,7 +58,7 @@ void a_pixel_pop(void)
     }
 
     a_pixel__state = *state;
-    free(state);
+    a_mem_free(state);
 
     a_pixel_blendSet(a_pixel__state.blend);
     a_pixel_colorSetRgba(a_pixel__state.red,
@@ -68,6 +73,7 @@ void a_pixel_reset(void)
     a_pixel_colorSetRgba(0, 0, 0, A_PIXEL_ALPHA_MAX);
     a_pixel_fillBlitSet(false);
     a_pixel_fillDrawSet(true);
+    a_pixel_paletteSet(NULL);
 }
 
 #if A_CONFIG_LIB_RENDER_SOFTWARE
@@ -213,3 +219,15 @@ void a_pixel_fillDrawSet(bool Fill)
         a_platform_software_draw__updateRoutines();
     #endif
 }
+
+void a_pixel_paletteSet(const APalette* Palette)
+{
+    #if !A_CONFIG_LIB_RENDER_SOFTWARE
+        // Textures hold the expanded pixels, so there is nothing to swap
+        if(Palette != NULL) {
+            A__FATAL("a_pixel_paletteSet: Not supported with SDL renderer");
+        }
+    #endif
+
+    a_pixel__state.palette = Palette;
+}
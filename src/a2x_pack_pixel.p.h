@@ -147,3 +147,7 @@ extern void a_pixel_colorSetPixel(APixel Pixel);
 
 extern void a_pixel_fillBlitSet(bool Fill);
 extern void a_pixel_fillDrawSet(bool Fill);
+
+#include "a2x_pack_palette.p.h"
+
+extern void a_pixel_paletteSet(const APalette* Palette);
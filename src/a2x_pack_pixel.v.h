@@ -26,11 +26,12 @@ typedef struct {
     APixel pixel;
     bool fillBlit;
     bool fillDraw;
+    const APalette* palette; // overrides indexed sprites' own palettes
 } APixelState;
 
 #include "a2x_pack_math.v.h"
 
-extern APixelState a_pixel__state;
+extern A__THREAD_LOCAL APixelState a_pixel__state;
 
 static inline void a_pixel__plain(APixel* Dst, APixel Pixel)
 {
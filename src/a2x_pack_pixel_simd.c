@@ -0,0 +1,631 @@
+/*
+    Copyright 2019 Alex Margarit <alex@alxm.org>
+    This file is part of a2x, a C video game framework.
+
+    This program is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    This program is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with this program.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#include "a2x_pack_pixel_simd.v.h"
+
+#if A__PIXEL_SIMD
+#if defined(__SSE2__)
+    #include <emmintrin.h>
+
+    typedef __m128i AVec; // 8 x 16-bit lanes, one 8-bit channel per lane
+#else
+    #include <arm_neon.h>
+
+    typedef uint16x8_t AVec;
+#endif
+
+#define A__VEC_PIXELS 8
+
+#if defined(__SSE2__)
+static inline AVec vecSet(int Value)
+{
+    return _mm_set1_epi16((short)Value);
+}
+
+#if A_CONFIG_SCREEN_BPP == 16
+#define A__VEC_UNPACK(V, Shift, Mask, Pack)                     \
+    _mm_slli_epi16(_mm_and_si128(_mm_srli_epi16(V, Shift),      \
+                                 _mm_set1_epi16(Mask)),         \
+                   Pack)
+
+#define A__VEC_PACK(C, Shift, Pack) \
+    _mm_slli_epi16(_mm_srli_epi16(C, Pack), Shift)
+
+static inline void vecLoad(const APixel* Pixels, AVec* Red, AVec* Green, AVec* Blue)
+{
+    AVec v = _mm_loadu_si128((const __m128i*)Pixels);
+
+    *Red = A__VEC_UNPACK(
+            v, A__PIXEL_SHIFT_RED, A__PIXEL_MASK_RED, A__PIXEL_PACK_RED);
+    *Green = A__VEC_UNPACK(
+            v, A__PIXEL_SHIFT_GREEN, A__PIXEL_MASK_GREEN, A__PIXEL_PACK_GREEN);
+    *Blue = A__VEC_UNPACK(
+            v, A__PIXEL_SHIFT_BLUE, A__PIXEL_MASK_BLUE, A__PIXEL_PACK_BLUE);
+}
+
+static inline void vecStore(APixel* Pixels, AVec Red, AVec Green, AVec Blue)
+{
+    AVec v = _mm_or_si128(
+                _mm_or_si128(
+                    A__VEC_PACK(Red, A__PIXEL_SHIFT_RED, A__PIXEL_PACK_RED),
+                    A__VEC_PACK(
+                        Green, A__PIXEL_SHIFT_GREEN, A__PIXEL_PACK_GREEN)),
+                A__VEC_PACK(Blue, A__PIXEL_SHIFT_BLUE, A__PIXEL_PACK_BLUE));
+
+    _mm_storeu_si128((__m128i*)Pixels, v);
+}
+#elif A_CONFIG_SCREEN_BPP == 32
+#define A__VEC_UNPACK(Lo, Hi, Shift, Mask)                                    \
+    _mm_packs_epi32(                                                          \
+        _mm_and_si128(_mm_srli_epi32(Lo, Shift), _mm_set1_epi32(Mask)),      \
+        _mm_and_si128(_mm_srli_epi32(Hi, Shift), _mm_set1_epi32(Mask)))
+
+static inline void vecLoad(const APixel* Pixels, AVec* Red, AVec* Green, AVec* Blue)
+{
+    AVec lo = _mm_loadu_si128((const __m128i*)Pixels);
+    AVec hi = _mm_loadu_si128((const __m128i*)(Pixels + 4));
+
+    *Red = A__VEC_UNPACK(lo, hi, A__PIXEL_SHIFT_RED, A__PIXEL_MASK_RED);
+    *Green = A__VEC_UNPACK(lo, hi, A__PIXEL_SHIFT_GREEN, A__PIXEL_MASK_GREEN);
+    *Blue = A__VEC_UNPACK(lo, hi, A__PIXEL_SHIFT_BLUE, A__PIXEL_MASK_BLUE);
+}
+
+static inline void vecStore(APixel* Pixels, AVec Red, AVec Green, AVec Blue)
+{
+    const AVec zero = _mm_setzero_si128();
+
+    AVec lo = _mm_or_si128(
+                _mm_or_si128(
+                    _mm_slli_epi32(
+                        _mm_unpacklo_epi16(Red, zero), A__PIXEL_SHIFT_RED),
+                    _mm_slli_epi32(
+                        _mm_unpacklo_epi16(Green, zero), A__PIXEL_SHIFT_GREEN)),
+                _mm_slli_epi32(
+                    _mm_unpacklo_epi16(Blue, zero), A__PIXEL_SHIFT_BLUE));
+
+    AVec hi = _mm_or_si128(
+                _mm_or_si128(
+                    _mm_slli_epi32(
+                        _mm_unpackhi_epi16(Red, zero), A__PIXEL_SHIFT_RED),
+                    _mm_slli_epi32(
+                        _mm_unpackhi_epi16(Green, zero), A__PIXEL_SHIFT_GREEN)),
+                _mm_slli_epi32(
+                    _mm_unpackhi_epi16(Blue, zero), A__PIXEL_SHIFT_BLUE));
+
+    _mm_storeu_si128((__m128i*)Pixels, lo);
+    _mm_storeu_si128((__m128i*)(Pixels + 4), hi);
+}
+#endif
+
+static inline AVec vecRgba(AVec Dst, AVec Src, AVec Alpha)
+{
+    // Bits 8-23 of the 32-bit product give an exact (Delta * Alpha) >> 8
+    AVec delta = _mm_sub_epi16(Src, Dst);
+    AVec lo = _mm_mullo_epi16(delta, Alpha);
+    AVec hi = _mm_mulhi_epi16(delta, Alpha);
+
+    return _mm_add_epi16(
+            Dst, _mm_or_si128(_mm_slli_epi16(hi, 8), _mm_srli_epi16(lo, 8)));
+}
+
+static inline AVec vecRgb25(AVec Dst, AVec Src, AVec Alpha)
+{
+    A_UNUSED(Alpha);
+
+    return _mm_add_epi16(_mm_sub_epi16(Dst, _mm_srli_epi16(Dst, 2)),
+                         _mm_srli_epi16(Src, 2));
+}
+
+static inline AVec vecRgb50(AVec Dst, AVec Src, AVec Alpha)
+{
+    A_UNUSED(Alpha);
+
+    return _mm_srli_epi16(_mm_add_epi16(Dst, Src), 1);
+}
+
+static inline AVec vecRgb75(AVec Dst, AVec Src, AVec Alpha)
+{
+    A_UNUSED(Alpha);
+
+    return _mm_add_epi16(_mm_srli_epi16(Dst, 2),
+                         _mm_sub_epi16(Src, _mm_srli_epi16(Src, 2)));
+}
+
+static inline AVec vecMod(AVec Dst, AVec Src, AVec Alpha)
+{
+    A_UNUSED(Alpha);
+
+    return _mm_srli_epi16(_mm_mullo_epi16(Dst, Src), 8);
+}
+
+static inline AVec vecAdd(AVec Dst, AVec Src, AVec Alpha)
+{
+    A_UNUSED(Alpha);
+
+    return _mm_min_epi16(_mm_add_epi16(Dst, Src), _mm_set1_epi16(255));
+}
+#else // NEON
+static inline AVec vecSet(int Value)
+{
+    return vdupq_n_u16((uint16_t)Value);
+}
+
+#if A_CONFIG_SCREEN_BPP == 16
+#define A__VEC_UNPACK(V, Shift, Mask, Pack)                             \
+    vshlq_u16(vandq_u16(vshlq_u16(V, vdupq_n_s16(-(Shift))),           \
+                        vdupq_n_u16(Mask)),                             \
+              vdupq_n_s16(Pack))
+
+#define A__VEC_PACK(C, Shift, Pack)                                     \
+    vshlq_u16(vshlq_u16(C, vdupq_n_s16(-(Pack))), vdupq_n_s16(Shift))
+
+static inline void vecLoad(const APixel* Pixels, AVec* Red, AVec* Green, AVec* Blue)
+{
+    AVec v = vld1q_u16(Pixels);
+
+    *Red = A__VEC_UNPACK(
+            v, A__PIXEL_SHIFT_RED, A__PIXEL_MASK_RED, A__PIXEL_PACK_RED);
+    *Green = A__VEC_UNPACK(
+            v, A__PIXEL_SHIFT_GREEN, A__PIXEL_MASK_GREEN, A__PIXEL_PACK_GREEN);
+    *Blue = A__VEC_UNPACK(
+            v, A__PIXEL_SHIFT_BLUE, A__PIXEL_MASK_BLUE, A__PIXEL_PACK_BLUE);
+}
+
+static inline void vecStore(APixel* Pixels, AVec Red, AVec Green, AVec Blue)
+{
+    vst1q_u16(
+        Pixels,
+        vorrq_u16(
+            vorrq_u16(
+                A__VEC_PACK(Red, A__PIXEL_SHIFT_RED, A__PIXEL_PACK_RED),
+                A__VEC_PACK(Green, A__PIXEL_SHIFT_GREEN, A__PIXEL_PACK_GREEN)),
+            A__VEC_PACK(Blue, A__PIXEL_SHIFT_BLUE, A__PIXEL_PACK_BLUE)));
+}
+#elif A_CONFIG_SCREEN_BPP == 32
+#define A__VEC_UNPACK(Lo, Hi, Shift, Mask)                                  \
+    vcombine_u16(                                                           \
+        vmovn_u32(vandq_u32(vshlq_u32(Lo, vdupq_n_s32(-(Shift))),          \
+                            vdupq_n_u32(Mask))),                            \
+        vmovn_u32(vandq_u32(vshlq_u32(Hi, vdupq_n_s32(-(Shift))),          \
+                            vdupq_n_u32(Mask))))
+
+#define A__VEC_PACK(C, Shift) \
+    vshlq_u32(vmovl_u16(C), vdupq_n_s32(Shift))
+
+static inline void vecLoad(const APixel* Pixels, AVec* Red, AVec* Green, AVec* Blue)
+{
+    uint32x4_t lo = vld1q_u32(Pixels);
+    uint32x4_t hi = vld1q_u32(Pixels + 4);
+
+    *Red = A__VEC_UNPACK(lo, hi, A__PIXEL_SHIFT_RED, A__PIXEL_MASK_RED);
+    *Green = A__VEC_UNPACK(lo, hi, A__PIXEL_SHIFT_GREEN, A__PIXEL_MASK_GREEN);
+    *Blue = A__VEC_UNPACK(lo, hi, A__PIXEL_SHIFT_BLUE, A__PIXEL_MASK_BLUE);
+}
+
+static inline void vecStore(APixel* Pixels, AVec Red, AVec Green, AVec Blue)
+{
+    vst1q_u32(
+        Pixels,
+        vorrq_u32(
+            vorrq_u32(
+                A__VEC_PACK(vget_low_u16(Red), A__PIXEL_SHIFT_RED),
+                A__VEC_PACK(vget_low_u16(Green), A__PIXEL_SHIFT_GREEN)),
+            A__VEC_PACK(vget_low_u16(Blue), A__PIXEL_SHIFT_BLUE)));
+
+    vst1q_u32(
+        Pixels + 4,
+        vorrq_u32(
+            vorrq_u32(
+                A__VEC_PACK(vget_high_u16(Red), A__PIXEL_SHIFT_RED),
+                A__VEC_PACK(vget_high_u16(Green), A__PIXEL_SHIFT_GREEN)),
+            A__VEC_PACK(vget_high_u16(Blue), A__PIXEL_SHIFT_BLUE)));
+}
+#endif
+
+static inline AVec vecRgba(AVec Dst, AVec Src, AVec Alpha)
+{
+    int16x8_t dst = vreinterpretq_s16_u16(Dst);
+    int16x8_t delta = vsubq_s16(vreinterpretq_s16_u16(Src), dst);
+    int16x8_t alpha = vreinterpretq_s16_u16(Alpha);
+
+    int32x4_t lo = vmull_s16(vget_low_s16(delta), vget_low_s16(alpha));
+    int32x4_t hi = vmull_s16(vget_high_s16(delta), vget_high_s16(alpha));
+
+    return vreinterpretq_u16_s16(
+            vaddq_s16(
+                dst, vcombine_s16(vshrn_n_s32(lo, 8), vshrn_n_s32(hi, 8))));
+}
+
+static inline AVec vecRgb25(AVec Dst, AVec Src, AVec Alpha)
+{
+    A_UNUSED(Alpha);
+
+    return vaddq_u16(vsubq_u16(Dst, vshrq_n_u16(Dst, 2)), vshrq_n_u16(Src, 2));
+}
+
+static inline AVec vecRgb50(AVec Dst, AVec Src, AVec Alpha)
+{
+    A_UNUSED(Alpha);
+
+    return vhaddq_u16(Dst, Src);
+}
+
+static inline AVec vecRgb75(AVec Dst, AVec Src, AVec Alpha)
+{
+    A_UNUSED(Alpha);
+
+    return vaddq_u16(vshrq_n_u16(Dst, 2), vsubq_u16(Src, vshrq_n_u16(Src, 2)));
+}
+
+static inline AVec vecMod(AVec Dst, AVec Src, AVec Alpha)
+{
+    A_UNUSED(Alpha);
+
+    return vshrq_n_u16(vmulq_u16(Dst, Src), 8);
+}
+
+static inline AVec vecAdd(AVec Dst, AVec Src, AVec Alpha)
+{
+    A_UNUSED(Alpha);
+
+    return vminq_u16(vaddq_u16(Dst, Src), vdupq_n_u16(255));
+}
+#endif
+
+#define a_pixel__scalarRgba(Dst, Red, Green, Blue, Alpha) \
+    a_pixel__rgba(Dst, Red, Green, Blue, Alpha)
+#define a_pixel__scalarRgb25(Dst, Red, Green, Blue, Alpha) \
+    a_pixel__rgb25(Dst, Red, Green, Blue)
+#define a_pixel__scalarRgb50(Dst, Red, Green, Blue, Alpha) \
+    a_pixel__rgb50(Dst, Red, Green, Blue)
+#define a_pixel__scalarRgb75(Dst, Red, Green, Blue, Alpha) \
+    a_pixel__rgb75(Dst, Red, Green, Blue)
+#define a_pixel__scalarMod(Dst, Red, Green, Blue, Alpha) \
+    a_pixel__mod(Dst, Red, Green, Blue)
+#define a_pixel__scalarAdd(Dst, Red, Green, Blue, Alpha) \
+    a_pixel__add(Dst, Red, Green, Blue)
+
+#define A__SPAN_FUNCTIONS(Blend, VecBlend, ScalarBlend)                    \
+    void a_pixel__span_##Blend##_data(APixel* Dst, const APixel* Src, int Len, int Alpha) \
+    {                                                                      \
+        const AVec alpha = vecSet(Alpha);                                  \
+                                                                           \
+        for( ; Len >= A__VEC_PIXELS; Len -= A__VEC_PIXELS) {               \
+            AVec sr, sg, sb, dr, dg, db;                                   \
+                                                                           \
+            vecLoad(Src, &sr, &sg, &sb);                                   \
+            vecLoad(Dst, &dr, &dg, &db);                                   \
+            vecStore(Dst,                                                  \
+                     VecBlend(dr, sr, alpha),                              \
+                     VecBlend(dg, sg, alpha),                              \
+                     VecBlend(db, sb, alpha));                             \
+                                                                           \
+            Dst += A__VEC_PIXELS;                                          \
+            Src += A__VEC_PIXELS;                                          \
+        }                                                                  \
+                                                                           \
+        while(Len--) {                                                     \
+            int r, g, b;                                                   \
+            a_pixel_toRgb(*Src++, &r, &g, &b);                             \
+            ScalarBlend(Dst++, r, g, b, Alpha);                            \
+        }                                                                  \
+    }                                                                      \
+                                                                           \
+    void a_pixel__span_##Blend##_flat(APixel* Dst, int Len, int Red, int Green, int Blue, int Alpha) \
+    {                                                                      \
+        const AVec alpha = vecSet(Alpha);                                  \
+        const AVec red = vecSet(Red);                                      \
+        const AVec green = vecSet(Green);                                  \
+        const AVec blue = vecSet(Blue);                                    \
+                                                                           \
+        for( ; Len >= A__VEC_PIXELS; Len -= A__VEC_PIXELS) {               \
+            AVec dr, dg, db;                                               \
+                                                                           \
+            vecLoad(Dst, &dr, &dg, &db);                                   \
+            vecStore(Dst,                                                  \
+                     VecBlend(dr, red, alpha),                             \
+                     VecBlend(dg, green, alpha),                           \
+                     VecBlend(db, blue, alpha));                           \
+                                                                           \
+            Dst += A__VEC_PIXELS;                                          \
+        }                                                                  \
+                                                                           \
+        while(Len--) {                                                     \
+            ScalarBlend(Dst++, Red, Green, Blue, Alpha);                   \
+        }                                                                  \
+    }
+
+A__SPAN_FUNCTIONS(rgba, vecRgba, a_pixel__scalarRgba)
+A__SPAN_FUNCTIONS(rgb25, vecRgb25, a_pixel__scalarRgb25)
+A__SPAN_FUNCTIONS(rgb50, vecRgb50, a_pixel__scalarRgb50)
+A__SPAN_FUNCTIONS(rgb75, vecRgb75, a_pixel__scalarRgb75)
+A__SPAN_FUNCTIONS(mod, vecMod, a_pixel__scalarMod)
+A__SPAN_FUNCTIONS(add, vecAdd, a_pixel__scalarAdd)
+#endif // A__PIXEL_SIMD
+
+#if A__PIXEL_PACKED
+// RGB565 spread out to 0000_0GGG_GGG0_0000_RRRR_R000_000B_BBBB, which leaves
+// enough room under each channel to multiply all three by a 5-bit alpha
+#define A__PACKED_MASK 0x07e0f81fu
+
+static uint8_t g_modRB[32][32];
+static uint8_t g_modG[64][64];
+
+void a_pixel__packedInit(void)
+{
+    for(int d = 0; d < 32; d++) {
+        for(int s = 0; s < 32; s++) {
+            g_modRB[d][s] = (uint8_t)((((d << 3) * (s << 3)) >> 8) >> 3);
+        }
+    }
+
+    for(int d = 0; d < 64; d++) {
+        for(int s = 0; s < 64; s++) {
+            g_modG[d][s] = (uint8_t)((((d << 2) * (s << 2)) >> 8) >> 2);
+        }
+    }
+}
+
+static inline uint32_t packedSpread(APixel Pixel)
+{
+    return (Pixel | ((uint32_t)Pixel << 16)) & A__PACKED_MASK;
+}
+
+static inline APixel packedJoin(uint32_t Spread)
+{
+    return (APixel)(Spread | (Spread >> 16));
+}
+
+static inline APixel packedMix(APixel Dst, APixel Src, unsigned Alpha)
+{
+    uint32_t d = packedSpread(Dst);
+    uint32_t s = packedSpread(Src);
+
+    return packedJoin(((d * (32 - Alpha) + s * Alpha) >> 5) & A__PACKED_MASK);
+}
+
+static inline APixel packedRgba(APixel Dst, APixel Src, int Alpha)
+{
+    return packedMix(Dst, Src, ((unsigned)Alpha + 4) >> 3);
+}
+
+static inline APixel packedRgb25(APixel Dst, APixel Src, int Alpha)
+{
+    A_UNUSED(Alpha);
+
+    return packedMix(Dst, Src, 8);
+}
+
+static inline APixel packedRgb50(APixel Dst, APixel Src, int Alpha)
+{
+    A_UNUSED(Alpha);
+
+    // Drop each channel's low bit before halving so nothing carries over
+    return (APixel)((((Dst ^ Src) & 0xf7de) >> 1) + (Dst & Src));
+}
+
+static inline APixel packedRgb75(APixel Dst, APixel Src, int Alpha)
+{
+    A_UNUSED(Alpha);
+
+    return packedMix(Dst, Src, 24);
+}
+
+#define A__PACKED_MOD(Table, Dst, Src, Shift, Mask)             \
+    ((unsigned)Table[((Dst) >> (Shift)) & (Mask)]               \
+                    [((Src) >> (Shift)) & (Mask)] << (Shift))
+
+static inline APixel packedMod(APixel Dst, APixel Src, int Alpha)
+{
+    A_UNUSED(Alpha);
+
+    return (APixel)
+        (A__PACKED_MOD(
+            g_modRB, Dst, Src, A__PIXEL_SHIFT_RED, A__PIXEL_MASK_RED)
+        | A__PACKED_MOD(
+            g_modG, Dst, Src, A__PIXEL_SHIFT_GREEN, A__PIXEL_MASK_GREEN)
+        | A__PACKED_MOD(
+            g_modRB, Dst, Src, A__PIXEL_SHIFT_BLUE, A__PIXEL_MASK_BLUE));
+}
+
+static inline APixel packedAdd(APixel Dst, APixel Src, int Alpha)
+{
+    A_UNUSED(Alpha);
+
+    uint32_t sum = packedSpread(Dst) + packedSpread(Src);
+
+    // Turn each channel's carry bit into a saturated channel
+    uint32_t carryRB = sum & 0x00010020u;
+    uint32_t carryG = sum & 0x08000000u;
+
+    sum |= (carryRB - (carryRB >> 5)) | (carryG - (carryG >> 6));
+
+    return packedJoin(sum & A__PACKED_MASK);
+}
+
+#define A__PACKED_SPAN_FUNCTIONS(Blend, PackedBlend)                       \
+    void a_pixel__span_##Blend##_data(APixel* Dst, const APixel* Src, int Len, int Alpha) \
+    {                                                                      \
+        while(Len--) {                                                     \
+            *Dst = PackedBlend(*Dst, *Src++, Alpha);                       \
+            Dst++;                                                         \
+        }                                                                  \
+    }                                                                      \
+                                                                           \
+    void a_pixel__span_##Blend##_flat(APixel* Dst, int Len, int Red, int Green, int Blue, int Alpha) \
+    {                                                                      \
+        const APixel src = a_pixel_fromRgb(Red, Green, Blue);              \
+                                                                           \
+        while(Len--) {                                                     \
+            *Dst = PackedBlend(*Dst, src, Alpha);                          \
+            Dst++;                                                         \
+        }                                                                  \
+    }
+
+A__PACKED_SPAN_FUNCTIONS(rgba, packedRgba)
+A__PACKED_SPAN_FUNCTIONS(rgb25, packedRgb25)
+A__PACKED_SPAN_FUNCTIONS(rgb50, packedRgb50)
+A__PACKED_SPAN_FUNCTIONS(rgb75, packedRgb75)
+A__PACKED_SPAN_FUNCTIONS(mod, packedMod)
+A__PACKED_SPAN_FUNCTIONS(add, packedAdd)
+#endif // A__PIXEL_PACKED
+
+#if A_CONFIG_LIB_RENDER_SOFTWARE
+#define A__FILL_BLOCK (32 / (int)sizeof(APixel))
+
+void a_pixel__fill(APixel* Dst, int Len, APixel Pixel)
+{
+    #if A_CONFIG_SCREEN_BPP == 16
+        const bool sameBytes = (Pixel & 0xff) == (Pixel >> 8);
+    #elif A_CONFIG_SCREEN_BPP == 32
+        const bool sameBytes = Pixel == (Pixel & 0xff) * 0x01010101u;
+    #endif
+
+    if(sameBytes) {
+        memset(Dst, Pixel & 0xff, (size_t)Len * sizeof(APixel));
+        return;
+    }
+
+    if(Len >= 2 * A__FILL_BLOCK) {
+        #if A__PIXEL_SIMD
+            #if defined(__SSE2__)
+                #if A_CONFIG_SCREEN_BPP == 16
+                    const __m128i pattern = _mm_set1_epi16((short)Pixel);
+                #else
+                    const __m128i pattern = _mm_set1_epi32((int)Pixel);
+                #endif
+
+                for( ; Len >= A__FILL_BLOCK; Len -= A__FILL_BLOCK) {
+                    _mm_storeu_si128((__m128i*)Dst, pattern);
+                    _mm_storeu_si128((__m128i*)Dst + 1, pattern);
+                    Dst += A__FILL_BLOCK;
+                }
+            #else
+                #if A_CONFIG_SCREEN_BPP == 16
+                    const uint16x8_t pattern = vdupq_n_u16(Pixel);
+                    #define A__FILL_STORE vst1q_u16
+                #else
+                    const uint32x4_t pattern = vdupq_n_u32(Pixel);
+                    #define A__FILL_STORE vst1q_u32
+                #endif
+
+                for( ; Len >= A__FILL_BLOCK; Len -= A__FILL_BLOCK) {
+                    A__FILL_STORE(Dst, pattern);
+                    A__FILL_STORE(Dst + A__FILL_BLOCK / 2, pattern);
+                    Dst += A__FILL_BLOCK;
+                }
+            #endif
+        #else
+            // Fixed-size copies compile to the widest stores the target has
+            APixel pattern[A__FILL_BLOCK];
+
+            for(int i = A__FILL_BLOCK; i--; ) {
+                pattern[i] = Pixel;
+            }
+
+            for( ; Len >= A__FILL_BLOCK; Len -= A__FILL_BLOCK) {
+                memcpy(Dst, pattern, sizeof(pattern));
+                Dst += A__FILL_BLOCK;
+            }
+        #endif
+    }
+
+    while(Len--) {
+        *Dst++ = Pixel;
+    }
+}
+
+// Constant zooms let the compiler merge each pixel's copies into wide stores
+static inline void zoomRow(APixel* Dst, const APixel* Src, int Len, const int Zoom)
+{
+    for( ; Len--; Dst += Zoom) {
+        const APixel pixel = *Src++;
+
+        for(int z = Zoom; z--; ) {
+            Dst[z] = pixel;
+        }
+    }
+}
+
+void a_pixel__zoom(APixel* Dst, const APixel* Src, int Len, int Zoom)
+{
+    #if A__PIXEL_SIMD && defined(__SSE2__)
+        #if A_CONFIG_SCREEN_BPP == 16
+            #define A__ZOOM_LO(V) _mm_unpacklo_epi16(V, V)
+            #define A__ZOOM_HI(V) _mm_unpackhi_epi16(V, V)
+            #define A__ZOOM_LO2(V) _mm_unpacklo_epi32(V, V)
+            #define A__ZOOM_HI2(V) _mm_unpackhi_epi32(V, V)
+        #else
+            #define A__ZOOM_LO(V) _mm_unpacklo_epi32(V, V)
+            #define A__ZOOM_HI(V) _mm_unpackhi_epi32(V, V)
+            #define A__ZOOM_LO2(V) _mm_unpacklo_epi64(V, V)
+            #define A__ZOOM_HI2(V) _mm_unpackhi_epi64(V, V)
+        #endif
+
+        #define A__ZOOM_BLOCK (16 / (int)sizeof(APixel))
+
+        if(Zoom == 2) {
+            for( ; Len >= A__ZOOM_BLOCK; Len -= A__ZOOM_BLOCK) {
+                __m128i v = _mm_loadu_si128((const __m128i*)Src);
+
+                _mm_storeu_si128((__m128i*)Dst, A__ZOOM_LO(v));
+                _mm_storeu_si128((__m128i*)Dst + 1, A__ZOOM_HI(v));
+
+                Src += A__ZOOM_BLOCK;
+                Dst += 2 * A__ZOOM_BLOCK;
+            }
+        } else if(Zoom == 4) {
+            for( ; Len >= A__ZOOM_BLOCK; Len -= A__ZOOM_BLOCK) {
+                __m128i v = _mm_loadu_si128((const __m128i*)Src);
+                __m128i lo = A__ZOOM_LO(v);
+                __m128i hi = A__ZOOM_HI(v);
+
+                _mm_storeu_si128((__m128i*)Dst, A__ZOOM_LO2(lo));
+                _mm_storeu_si128((__m128i*)Dst + 1, A__ZOOM_HI2(lo));
+                _mm_storeu_si128((__m128i*)Dst + 2, A__ZOOM_LO2(hi));
+                _mm_storeu_si128((__m128i*)Dst + 3, A__ZOOM_HI2(hi));
+
+                Src += A__ZOOM_BLOCK;
+                Dst += 4 * A__ZOOM_BLOCK;
+            }
+        }
+    #endif
+
+    switch(Zoom) {
+        case 1: {
+            memcpy(Dst, Src, (size_t)Len * sizeof(APixel));
+        } break;
+
+        case 2: {
+            zoomRow(Dst, Src, Len, 2);
+        } break;
+
+        case 3: {
+            zoomRow(Dst, Src, Len, 3);
+        } break;
+
+        case 4: {
+            zoomRow(Dst, Src, Len, 4);
+        } break;
+
+        default: {
+            zoomRow(Dst, Src, Len, Zoom);
+        } break;
+    }
+}
+#endif // A_CONFIG_LIB_RENDER_SOFTWARE
@@ -0,0 +1,63 @@
+/*
+    Copyright 2019 Alex Margarit <alex@alxm.org>
+    This file is part of a2x, a C video game framework.
+
+    This program is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    This program is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with this program.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#pragma once
+
+#include "a2x_pack_pixel_simd.p.h"
+
+#include "a2x_pack_pixel.v.h"
+
+#if A_CONFIG_LIB_RENDER_SOFTWARE \
+    && (defined(__SSE2__) || defined(__ARM_NEON) || defined(__ARM_NEON__))
+    #define A__PIXEL_SIMD 1
+#else
+    #define A__PIXEL_SIMD 0
+#endif
+
+#if A_CONFIG_LIB_RENDER_SOFTWARE && A_CONFIG_SCREEN_BPP == 16 \
+    && A_CONFIG_SCREEN_BLEND_PACKED && !A__PIXEL_SIMD
+    #define A__PIXEL_PACKED 1
+#else
+    #define A__PIXEL_PACKED 0
+#endif
+
+#define A__PIXEL_SPANS (A__PIXEL_SIMD || A__PIXEL_PACKED)
+
+#if A__PIXEL_PACKED
+    extern void a_pixel__packedInit(void);
+#endif
+
+#if A_CONFIG_LIB_RENDER_SOFTWARE
+    extern void a_pixel__fill(APixel* Dst, int Len, APixel Pixel);
+    extern void a_pixel__zoom(APixel* Dst, const APixel* Src, int Len, int Zoom);
+#endif
+
+#if A__PIXEL_SPANS
+    extern void a_pixel__span_rgba_data(APixel* Dst, const APixel* Src, int Len, int Alpha);
+    extern void a_pixel__span_rgba_flat(APixel* Dst, int Len, int Red, int Green, int Blue, int Alpha);
+    extern void a_pixel__span_rgb25_data(APixel* Dst, const APixel* Src, int Len, int Alpha);
+    extern void a_pixel__span_rgb25_flat(APixel* Dst, int Len, int Red, int Green, int Blue, int Alpha);
+    extern void a_pixel__span_rgb50_data(APixel* Dst, const APixel* Src, int Len, int Alpha);
+    extern void a_pixel__span_rgb50_flat(APixel* Dst, int Len, int Red, int Green, int Blue, int Alpha);
+    extern void a_pixel__span_rgb75_data(APixel* Dst, const APixel* Src, int Len, int Alpha);
+    extern void a_pixel__span_rgb75_flat(APixel* Dst, int Len, int Red, int Green, int Blue, int Alpha);
+    extern void a_pixel__span_mod_data(APixel* Dst, const APixel* Src, int Len, int Alpha);
+    extern void a_pixel__span_mod_flat(APixel* Dst, int Len, int Red, int Green, int Blue, int Alpha);
+    extern void a_pixel__span_add_data(APixel* Dst, const APixel* Src, int Len, int Alpha);
+    extern void a_pixel__span_add_flat(APixel* Dst, int Len, int Red, int Green, int Blue, int Alpha);
+#endif
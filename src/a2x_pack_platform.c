@@ -25,6 +25,7 @@
 #include "a2x_pack_platform_sdl.v.h"
 #include "a2x_pack_platform_software_blit.v.h"
 #include "a2x_pack_platform_software_draw.v.h"
+#include "a2x_pack_platform_software_tiles.v.h"
 #include "a2x_pack_platform_wiz.v.h"
 
 void a_platform__init(void)
@@ -62,6 +63,13 @@ void a_platform__init(void)
 
         a_platform_software_blit__init();
         a_platform_software_draw__init();
+
+        #if A__TILES
+            a_out__message("Software rendering on %d threads",
+                           A_CONFIG_SCREEN_THREADS + 1);
+
+            a_platform_software_tiles__init();
+        #endif
     #elif A_CONFIG_LIB_RENDER_SDL
         a_out__message("SDL2 rendering");
     #endif
@@ -69,6 +77,10 @@ void a_platform__init(void)
 
 void a_platform__uninit(void)
 {
+    #if A__TILES
+        a_platform_software_tiles__uninit();
+    #endif
+
     #if A_CONFIG_SYSTEM_GP2X
         a_platform_gp2x__uninit();
     #elif A_CONFIG_SYSTEM_PANDORA
@@ -56,19 +56,30 @@ extern void a_platform__renderTargetPixelsGet(APixel* Pixels, int Width);
 extern void a_platform__renderTargetClipSet(int X, int Y, int Width, int Height);
 
 extern void a_platform__drawPixel(int X, int Y);
+extern void a_platform__drawPixels(const AVectorInt* Points, unsigned NumPoints);
 extern void a_platform__drawLine(int X1, int Y1, int X2, int Y2);
+extern void a_platform__drawLines(const AVectorInt* Points, unsigned NumLines);
+extern void a_platform__drawLineAntialiased(int X1, int Y1, int X2, int Y2);
 extern void a_platform__drawHLine(int X1, int X2, int Y);
 extern void a_platform__drawVLine(int X, int Y1, int Y2);
 extern void a_platform__drawRectangleFilled(int X, int Y, int Width, int Height);
 extern void a_platform__drawRectangleOutline(int X, int Y, int Width, int Height);
+extern void a_platform__drawRectanglesFilled(const AVectorInt* Rectangles, unsigned NumRectangles);
+extern void a_platform__drawRectanglesOutline(const AVectorInt* Rectangles, unsigned NumRectangles);
 extern void a_platform__drawCircleOutline(int X, int Y, int Radius);
 extern void a_platform__drawCircleFilled(int X, int Y, int Radius);
+extern void a_platform__drawCircleAntialiased(int X, int Y, int Radius);
+extern void a_platform__drawEllipseOutline(int X, int Y, int RadiusX, int RadiusY);
+extern void a_platform__drawEllipseFilled(int X, int Y, int RadiusX, int RadiusY);
+extern void a_platform__drawTriangleFilled(int X1, int Y1, int X2, int Y2, int X3, int Y3);
 
 extern APlatformTexture* a_platform__textureNewScreen(int Width, int Height);
 extern APlatformTexture* a_platform__textureNewSprite(const ASprite* Sprite);
 extern void a_platform__textureFree(APlatformTexture* Texture);
 extern void a_platform__textureBlit(const APlatformTexture* Texture, int X, int Y, bool FillFlat);
 extern void a_platform__textureBlitEx(const APlatformTexture* Texture, int X, int Y, AFix Scale, unsigned Angle, int CenterX, int CenterY, bool FillFlat);
+extern void a_platform__textureAtlasBegin(void);
+extern void a_platform__textureAtlasEnd(void);
 
 extern bool a_platform__soundMuteGet(void);
 extern void a_platform__soundMuteFlip(void);
@@ -20,6 +20,7 @@
 
 #if A_CONFIG_SYSTEM_PANDORA
 #include "a2x_pack_file.v.h"
+#include "a2x_pack_mem.v.h"
 #include "a2x_pack_out.v.h"
 #include "a2x_pack_str.v.h"
 
@@ -92,7 +93,7 @@ void a_platform_pandora__uninit(void)
     }
 
     for(int i = 0; i < 2; i++) {
-        free(g_nubModes[i]);
+        a_mem_free(g_nubModes[i]);
     }
 }
 #endif // A_CONFIG_SYSTEM_PANDORA
@@ -21,12 +21,17 @@
 #if A_CONFIG_LIB_RENDER_SDL
 #include <SDL.h>
 
+#include "a2x_pack_draw.v.h"
+#include "a2x_pack_list.v.h"
+#include "a2x_pack_listit.v.h"
 #include "a2x_pack_main.v.h"
+#include "a2x_pack_math.v.h"
 #include "a2x_pack_mem.v.h"
 #include "a2x_pack_out.v.h"
 #include "a2x_pack_pixel.v.h"
 #include "a2x_pack_platform.v.h"
 #include "a2x_pack_platform_sdl_video.v.h"
+#include "a2x_pack_screen.v.h"
 
 typedef enum {
     A_TEXTURE__INVALID = -1,
@@ -36,13 +41,57 @@ typedef enum {
     A_TEXTURE__NUM
 } APlatformTextureVersion;
 
+#define A__ATLAS_SIZE 1024
+#define A__ATLAS_SPRITE_MAX 256
+
+typedef struct {
+    SDL_Texture* texture[A_TEXTURE__NUM]; // created on first use
+    AList* textures; // list of APlatformTexture on this page
+    int w, h;
+} APlatformAtlasPage;
+
+typedef struct {
+    int x, y, w;
+} APlatformAtlasSkyline;
+
 struct APlatformTexture {
-    APixel* pixels;
-    size_t pixelsSize;
+    const ASprite* spr; // source pixels for the texture versions, or NULL
     int w, h;
-    SDL_Texture* texture[A_TEXTURE__NUM];
+    SDL_Texture* texture[A_TEXTURE__NUM]; // created on first use
+    APlatformAtlasPage* page; // shared atlas texture, or NULL
+    int x, y; // area on the atlas page
+    AListNode* node; // in the atlas page, or pending in the open atlas group
 };
 
+static struct {
+    AList* pending; // list of APlatformTexture
+    unsigned depth;
+} g_atlas;
+
+#define A__BATCH SDL_VERSION_ATLEAST(2, 0, 18)
+
+// Stack buffer size for bulk point and rectangle submissions
+#define A__BULK_CHUNK 256
+
+#if A__BATCH
+    #define A__BATCH_BUCKETS 8
+    #define A__BATCH_QUADS 2048
+
+    typedef struct {
+        SDL_Texture* texture;
+        SDL_BlendMode blend;
+        float x1, y1, x2, y2; // bounding box of all queued quads
+        unsigned num, capacity;
+        SDL_Vertex* vertices;
+    } APlatformBatchBucket;
+
+    static struct {
+        APlatformBatchBucket buckets[A__BATCH_BUCKETS];
+        unsigned num;
+        int indices[A__BATCH_QUADS * 6];
+    } g_batch;
+#endif
+
 static inline SDL_BlendMode pixelBlendToSdlBlend(void)
 {
     switch(a_pixel__state.blend) {
@@ -77,6 +126,153 @@ static inline uint8_t pixelAlphaToSdlAlpha(void)
     }
 }
 
+void a_platform_sdl_render__init(void)
+{
+    g_atlas.pending = a_list_new();
+
+    #if A__BATCH
+        for(int q = 0; q < A__BATCH_QUADS; q++) {
+            int* i = &g_batch.indices[q * 6];
+            int v = q * 4;
+
+            i[0] = v + 0;
+            i[1] = v + 1;
+            i[2] = v + 2;
+            i[3] = v + 2;
+            i[4] = v + 3;
+            i[5] = v + 0;
+        }
+    #endif
+}
+
+void a_platform_sdl_render__uninit(void)
+{
+    a_list_free(g_atlas.pending);
+
+    #if A__BATCH
+        for(int b = 0; b < A__BATCH_BUCKETS; b++) {
+            a_mem_free(g_batch.buckets[b].vertices);
+        }
+    #endif
+}
+
+void a_platform_sdl_render__flush(void)
+{
+    #if A__BATCH
+        for(unsigned b = 0; b < g_batch.num; b++) {
+            APlatformBatchBucket* bucket = &g_batch.buckets[b];
+
+            if(SDL_SetTextureBlendMode(bucket->texture, bucket->blend) < 0) {
+                a_out__error("SDL_SetTextureBlendMode: %s", SDL_GetError());
+            }
+
+            if(SDL_RenderGeometry(a__sdlRenderer,
+                                  bucket->texture,
+                                  bucket->vertices,
+                                  (int)bucket->num * 4,
+                                  g_batch.indices,
+                                  (int)bucket->num * 6) < 0) {
+
+                a_out__error("SDL_RenderGeometry: %s", SDL_GetError());
+            }
+
+            bucket->num = 0;
+        }
+
+        g_batch.num = 0;
+    #endif
+}
+
+#if A__BATCH
+static APlatformBatchBucket* batchBucketGet(SDL_Texture* Texture, SDL_BlendMode Blend, float X1, float Y1, float X2, float Y2)
+{
+    // A quad can join an older bucket with the same state only if it does
+    // not overlap anything queued after that bucket, to keep draw order
+    for(unsigned b = g_batch.num; b--; ) {
+        APlatformBatchBucket* bucket = &g_batch.buckets[b];
+
+        if(bucket->texture == Texture && bucket->blend == Blend) {
+            if(bucket->num < A__BATCH_QUADS) {
+                return bucket;
+            }
+
+            break;
+        }
+
+        if(X1 < bucket->x2 && X2 > bucket->x1
+            && Y1 < bucket->y2 && Y2 > bucket->y1) {
+
+            break;
+        }
+    }
+
+    if(g_batch.num == A__BATCH_BUCKETS) {
+        a_platform_sdl_render__flush();
+    }
+
+    APlatformBatchBucket* bucket = &g_batch.buckets[g_batch.num++];
+
+    bucket->texture = Texture;
+    bucket->blend = Blend;
+    bucket->x1 = X1;
+    bucket->y1 = Y1;
+    bucket->x2 = X2;
+    bucket->y2 = Y2;
+
+    return bucket;
+}
+
+static void batchQuadAdd(SDL_Texture* Texture, SDL_BlendMode Blend, const SDL_FPoint* Corners, SDL_FPoint Uv1, SDL_FPoint Uv2, SDL_Color Color)
+{
+    float x1 = Corners[0].x, y1 = Corners[0].y;
+    float x2 = x1, y2 = y1;
+
+    for(int c = 1; c < 4; c++) {
+        x1 = Corners[c].x < x1 ? Corners[c].x : x1;
+        y1 = Corners[c].y < y1 ? Corners[c].y : y1;
+        x2 = Corners[c].x > x2 ? Corners[c].x : x2;
+        y2 = Corners[c].y > y2 ? Corners[c].y : y2;
+    }
+
+    APlatformBatchBucket* bucket = batchBucketGet(
+                                    Texture, Blend, x1, y1, x2, y2);
+
+    if(bucket->num * 4 == bucket->capacity) {
+        unsigned capacity = bucket->capacity < 64
+                                ? 64 : bucket->capacity * 2;
+        SDL_Vertex* vertices = a_mem_malloc(capacity * sizeof(SDL_Vertex));
+
+        if(bucket->vertices) {
+            memcpy(vertices,
+                   bucket->vertices,
+                   bucket->capacity * sizeof(SDL_Vertex));
+
+            a_mem_free(bucket->vertices);
+        }
+
+        bucket->vertices = vertices;
+        bucket->capacity = capacity;
+    }
+
+    bucket->x1 = x1 < bucket->x1 ? x1 : bucket->x1;
+    bucket->y1 = y1 < bucket->y1 ? y1 : bucket->y1;
+    bucket->x2 = x2 > bucket->x2 ? x2 : bucket->x2;
+    bucket->y2 = y2 > bucket->y2 ? y2 : bucket->y2;
+
+    SDL_Vertex* v = &bucket->vertices[bucket->num++ * 4];
+
+    for(int c = 0; c < 4; c++) {
+        v[c].position = Corners[c];
+        v[c].color = Color;
+    }
+
+    v[0].tex_coord = Uv1;
+    v[1].tex_coord = (SDL_FPoint){Uv2.x, Uv1.y};
+    v[2].tex_coord = Uv2;
+    v[3].tex_coord = (SDL_FPoint){Uv1.x, Uv2.y};
+}
+#endif
+
 void a_platform__renderSetDrawColor(void)
 {
     if(SDL_SetRenderDrawColor(a__sdlRenderer,
@@ -98,18 +294,68 @@ void a_platform__renderSetBlendMode(void)
 
 void a_platform__drawPixel(int X, int Y)
 {
+    a_platform_sdl_render__flush();
+
     if(SDL_RenderDrawPoint(a__sdlRenderer, X, Y) < 0) {
         a_out__error("SDL_RenderDrawPoint: %s", SDL_GetError());
     }
 }
 
+void a_platform__drawPixels(const AVectorInt* Points, unsigned NumPoints)
+{
+    a_platform_sdl_render__flush();
+
+    SDL_Point points[A__BULK_CHUNK];
+
+    while(NumPoints > 0) {
+        unsigned num = a_math_minu(NumPoints, A__BULK_CHUNK);
+
+        for(unsigned p = 0; p < num; p++) {
+            points[p].x = Points[p].x;
+            points[p].y = Points[p].y;
+        }
+
+        if(SDL_RenderDrawPoints(a__sdlRenderer, points, (int)num) < 0) {
+            a_out__error("SDL_RenderDrawPoints: %s", SDL_GetError());
+        }
+
+        Points += num;
+        NumPoints -= num;
+    }
+}
+
 void a_platform__drawLine(int X1, int Y1, int X2, int Y2)
 {
+    a_platform_sdl_render__flush();
+
     if(SDL_RenderDrawLine(a__sdlRenderer, X1, Y1, X2, Y2) < 0) {
         a_out__error("SDL_RenderDrawLine: %s", SDL_GetError());
     }
 }
 
+void a_platform__drawLines(const AVectorInt* Points, unsigned NumLines)
+{
+    a_platform_sdl_render__flush();
+
+    // SDL_RenderDrawLines draws a connected strip, these are separate lines
+    for(unsigned l = 0; l < NumLines; l++, Points += 2) {
+        if(SDL_RenderDrawLine(a__sdlRenderer,
+                              Points[0].x,
+                              Points[0].y,
+                              Points[1].x,
+                              Points[1].y) < 0) {
+
+            a_out__error("SDL_RenderDrawLine: %s", SDL_GetError());
+        }
+    }
+}
+
+void a_platform__drawLineAntialiased(int X1, int Y1, int X2, int Y2)
+{
+    // No coverage blending here, draw the aliased line instead
+    a_platform__drawLine(X1, Y1, X2, Y2);
+}
+
 void a_platform__drawHLine(int X1, int X2, int Y)
 {
     a_platform__drawRectangleFilled(X1, Y, X2 - X1 + 1, 1);
@@ -122,6 +368,8 @@ void a_platform__drawVLine(int X, int Y1, int Y2)
 
 void a_platform__drawRectangleFilled(int X, int Y, int Width, int Height)
 {
+    a_platform_sdl_render__flush();
+
     SDL_Rect area = {X, Y, Width, Height};
 
     if(SDL_RenderFillRect(a__sdlRenderer, &area) < 0) {
@@ -147,8 +395,81 @@ void a_platform__drawRectangleOutline(int X, int Y, int Width, int Height)
     a_platform__drawRectangleFilled(X + Width - 1, Y + 1, 1, Height - 2);
 }
 
+static void fillRects(const SDL_Rect* Rects, unsigned NumRects)
+{
+    if(SDL_RenderFillRects(a__sdlRenderer, Rects, (int)NumRects) < 0) {
+        a_out__error("SDL_RenderFillRects: %s", SDL_GetError());
+    }
+}
+
+void a_platform__drawRectanglesFilled(const AVectorInt* Rectangles, unsigned NumRectangles)
+{
+    a_platform_sdl_render__flush();
+
+    SDL_Rect rects[A__BULK_CHUNK];
+    unsigned num = 0;
+
+    for(unsigned r = 0; r < NumRectangles; r++, Rectangles += 2) {
+        rects[num++] = (SDL_Rect){Rectangles[0].x,
+                                  Rectangles[0].y,
+                                  Rectangles[1].x,
+                                  Rectangles[1].y};
+
+        if(num == A__BULK_CHUNK) {
+            fillRects(rects, num);
+            num = 0;
+        }
+    }
+
+    if(num > 0) {
+        fillRects(rects, num);
+    }
+}
+
+void a_platform__drawRectanglesOutline(const AVectorInt* Rectangles, unsigned NumRectangles)
+{
+    a_platform_sdl_render__flush();
+
+    // Same 1px strips as a_platform__drawRectangleOutline, up to 4 each
+    SDL_Rect rects[A__BULK_CHUNK];
+    unsigned num = 0;
+
+    for(unsigned r = 0; r < NumRectangles; r++, Rectangles += 2) {
+        const int x = Rectangles[0].x;
+        const int y = Rectangles[0].y;
+        const int w = Rectangles[1].x;
+        const int h = Rectangles[1].y;
+
+        if(num > A__BULK_CHUNK - 4) {
+            fillRects(rects, num);
+            num = 0;
+        }
+
+        rects[num++] = (SDL_Rect){x, y, w, 1};
+
+        if(h <= 1) {
+            continue;
+        }
+
+        rects[num++] = (SDL_Rect){x, y + h - 1, w, 1};
+
+        if(w <= 1 || h <= 2) {
+            continue;
+        }
+
+        rects[num++] = (SDL_Rect){x, y + 1, 1, h - 2};
+        rects[num++] = (SDL_Rect){x + w - 1, y + 1, 1, h - 2};
+    }
+
+    if(num > 0) {
+        fillRects(rects, num);
+    }
+}
+
 void a_platform__drawCircleOutline(int X, int Y, int Radius)
 {
+    a_platform_sdl_render__flush();
+
     // Using inclusive coords
     if(--Radius <= 0) {
         if(Radius == 0) {
@@ -256,6 +577,8 @@ void a_platform__drawCircleOutline(int X, int Y, int Radius)
 
 void a_platform__drawCircleFilled(int X, int Y, int Radius)
 {
+    a_platform_sdl_render__flush();
+
     // Using inclusive coords
     if(--Radius <= 0) {
         if(Radius == 0) {
@@ -330,11 +653,134 @@ void a_platform__drawCircleFilled(int X, int Y, int Radius)
     }
 }
 
-APlatformTexture* a_platform__textureNewScreen(int Width, int Height)
+void a_platform__drawCircleAntialiased(int X, int Y, int Radius)
+{
+    // No coverage blending here, draw the aliased outline instead
+    a_platform__drawCircleOutline(X, Y, Radius);
+}
+
+static void drawEllipse(int X, int Y, int RadiusX, int RadiusY, bool Fill)
+{
+    a_platform_sdl_render__flush();
+
+    SDL_Rect rects[A__BULK_CHUNK];
+    unsigned num = 0;
+    ADrawEllipseEdge ellipse;
+
+    a_draw__ellipseInit(&ellipse, RadiusX, RadiusY);
+
+    for(int y = 0; y < RadiusY && ellipse.x >= 0; y++) {
+        const int x = ellipse.x;
+
+        a_draw__ellipseStep(&ellipse);
+
+        if(num > A__BULK_CHUNK - 4) {
+            fillRects(rects, num);
+            num = 0;
+        }
+
+        if(Fill) {
+            rects[num++] = (SDL_Rect){X - 1 - x, Y + y, 2 * x + 2, 1};
+            rects[num++] = (SDL_Rect){X - 1 - x, Y - 1 - y, 2 * x + 2, 1};
+        } else {
+            const int next = y + 1 < RadiusY ? ellipse.x : -1;
+            const int inner = a_math_min(x, next + 1);
+            const int w = x - inner + 1;
+
+            rects[num++] = (SDL_Rect){X + inner, Y + y, w, 1};
+            rects[num++] = (SDL_Rect){X - 1 - x, Y + y, w, 1};
+            rects[num++] = (SDL_Rect){X + inner, Y - 1 - y, w, 1};
+            rects[num++] = (SDL_Rect){X - 1 - x, Y - 1 - y, w, 1};
+        }
+    }
+
+    if(num > 0) {
+        fillRects(rects, num);
+    }
+}
+
+void a_platform__drawEllipseOutline(int X, int Y, int RadiusX, int RadiusY)
+{
+    drawEllipse(X, Y, RadiusX, RadiusY, false);
+}
+
+void a_platform__drawEllipseFilled(int X, int Y, int RadiusX, int RadiusY)
+{
+    drawEllipse(X, Y, RadiusX, RadiusY, true);
+}
+
+void a_platform__drawTriangleFilled(int X1, int Y1, int X2, int Y2, int X3, int Y3)
+{
+    a_platform_sdl_render__flush();
+
+    #if A__BATCH
+        const SDL_Color color = {(uint8_t)a_pixel__state.red,
+                                 (uint8_t)a_pixel__state.green,
+                                 (uint8_t)a_pixel__state.blue,
+                                 pixelAlphaToSdlAlpha()};
+
+        const SDL_Vertex vertices[3] = {
+            {{(float)X1, (float)Y1}, color, {0, 0}},
+            {{(float)X2, (float)Y2}, color, {0, 0}},
+            {{(float)X3, (float)Y3}, color, {0, 0}},
+        };
+
+        if(SDL_RenderGeometry(a__sdlRenderer, NULL, vertices, 3, NULL, 0) < 0) {
+            a_out__error("SDL_RenderGeometry: %s", SDL_GetError());
+        }
+    #else
+        // Vertex 2 is either right or left of the long edge from 1 to 3
+        const int64_t side = (int64_t)(X2 - X1) * (Y3 - Y1)
+                                - (int64_t)(X3 - X1) * (Y2 - Y1);
+
+        if(side == 0) {
+            return;
+        }
+
+        const int yStart = a_math_max(Y1, a__screen.clipY);
+        const int yEnd = a_math_min(Y3, a__screen.clipY2);
+        const int yMid = a_math_min(a_math_max(Y2, yStart), yEnd);
+
+        if(yStart >= yEnd) {
+            return;
+        }
+
+        const int numScanlines = yEnd - yStart;
+        SDL_Rect scanlines[numScanlines];
+
+        ADrawEdge edgeLong, edgeShort;
+        ADrawEdge* left = side > 0 ? &edgeLong : &edgeShort;
+        ADrawEdge* right = side > 0 ? &edgeShort : &edgeLong;
+
+        a_draw__edgeInit(&edgeLong, X1, Y1, X3, Y3, yStart);
+
+        if(yStart < yMid) {
+            a_draw__edgeInit(&edgeShort, X1, Y1, X2, Y2, yStart);
+        }
+
+        for(int y = yStart; y < yEnd; y++) {
+            if(y == yMid) {
+                a_draw__edgeInit(&edgeShort, X2, Y2, X3, Y3, yMid);
+            }
+
+            scanlines[y - yStart] =
+                (SDL_Rect){left->x, y, a_math_max(right->x - left->x, 0), 1};
+
+            a_draw__edgeStep(&edgeLong);
+            a_draw__edgeStep(&edgeShort);
+        }
+
+        if(SDL_RenderFillRects(a__sdlRenderer, scanlines, numScanlines) < 0) {
+            a_out__error("SDL_RenderFillRects: %s", SDL_GetError());
+        }
+    #endif
+}
+
+static SDL_Texture* sdlTextureNew(int Width, int Height, int Access, const APixel* Pixels)
 {
     SDL_Texture* tex = SDL_CreateTexture(a__sdlRenderer,
                                          A_SDL__PIXEL_FORMAT,
-                                         SDL_TEXTUREACCESS_TARGET,
+                                         Access,
                                          Width,
                                          Height);
 
@@ -342,103 +788,356 @@ APlatformTexture* a_platform__textureNewScreen(int Width, int Height)
         A__FATAL("SDL_CreateTexture: %s", SDL_GetError());
     }
 
+    if(Pixels && SDL_UpdateTexture(
+                    tex, NULL, Pixels, Width * (int)sizeof(APixel)) < 0) {
+
+        A__FATAL("SDL_UpdateTexture: %s", SDL_GetError());
+    }
+
     if(SDL_SetTextureBlendMode(tex, SDL_BLENDMODE_BLEND) < 0) {
         a_out__error("SDL_SetTextureBlendMode: %s", SDL_GetError());
     }
 
-    APlatformTexture* screen = a_mem_malloc(sizeof(APlatformTexture));
+    return tex;
+}
 
-    screen->pixels = NULL;
-    screen->pixelsSize = 0;
-    screen->w = Width;
-    screen->h = Height;
+static void texturePixelsMake(const APlatformTexture* Texture, APlatformTextureVersion Version, APixel* Dst, int DstWidth)
+{
+    const APixel* src = Texture->spr->pixels;
+    const uint8_t* srcAlpha = Texture->spr->alpha;
+    const APixel alpha = (APixel)A__PIXEL_MASK_ALPHA << A__PIXEL_SHIFT_ALPHA;
+    const APixel white = a_pixel_fromHex(0xffffff);
+
+    for(int y = Texture->h; y--; Dst += DstWidth) {
+        for(int x = 0; x < Texture->w; x++) {
+            APixel p = *src++;
+
+            if(p == a_sprite__colorKey) {
+                if(Version != A_TEXTURE__NORMAL) {
+                    // Set full color for transparent pixel
+                    p |= white;
+                }
+            } else {
+                if(srcAlpha) {
+                    // Use the sprite's own alpha for this pixel
+                    p |= (APixel)(srcAlpha[x] >> (8 - A__PIXEL_BITS_ALPHA)
+                                    << A__PIXEL_SHIFT_ALPHA);
+                } else {
+                    // Set full alpha for non-transparent pixel
+                    p |= alpha;
+                }
 
-    screen->texture[A_TEXTURE__NORMAL] = tex;
+                if(Version == A_TEXTURE__COLORMOD_FLAT) {
+                    // Set full color for non-transparent pixel
+                    p |= white;
+                }
+            }
 
-    for(int t = 1; t < A_TEXTURE__NUM; t++) {
-        screen->texture[t] = NULL;
+            Dst[x] = p;
+        }
+
+        if(srcAlpha) {
+            srcAlpha += Texture->w;
+        }
     }
+}
 
-    return screen;
+static void textureTexturesFree(APlatformTexture* Texture)
+{
+    if(Texture->page) {
+        APlatformAtlasPage* page = Texture->page;
+
+        a_list_removeNode(Texture->node);
+
+        if(a_list_isEmpty(page->textures)) {
+            for(int t = A_TEXTURE__NUM; t--; ) {
+                if(page->texture[t]) {
+                    SDL_DestroyTexture(page->texture[t]);
+                }
+            }
+
+            a_list_free(page->textures);
+            a_mem_free(page);
+        }
+
+        Texture->page = NULL;
+        Texture->x = 0;
+        Texture->y = 0;
+    } else if(Texture->node) {
+        a_list_removeNode(Texture->node);
+    } else {
+        for(int t = A_TEXTURE__NUM; t--; ) {
+            if(Texture->texture[t]) {
+                SDL_DestroyTexture(Texture->texture[t]);
+                Texture->texture[t] = NULL;
+            }
+        }
+    }
+
+    Texture->node = NULL;
 }
 
-APlatformTexture* a_platform__textureNewSprite(const ASprite* Sprite)
+static bool skylineFit(const APlatformAtlasSkyline* Line, unsigned Index, int Width, int PageWidth, int* Y)
 {
-    APlatformTexture* texture = Sprite->texture;
-    int width = Sprite->w;
-    int height = Sprite->h;
+    if(Line[Index].x + Width > PageWidth) {
+        return false;
+    }
 
-    if(texture == NULL) {
-        texture = a_mem_zalloc(sizeof(APlatformTexture));
+    int y = 0;
+
+    for(unsigned i = Index; Width > 0; i++) {
+        y = a_math_max(y, Line[i].y);
+        Width -= Line[i].w;
     }
 
-    if(Sprite->pixelsSize > texture->pixelsSize) {
-        free(texture->pixels);
+    *Y = y;
 
-        texture->pixels = a_mem_malloc(Sprite->pixelsSize);
-        texture->pixelsSize = Sprite->pixelsSize;
+    return true;
+}
+
+static bool skylineAdd(APlatformAtlasSkyline* Line, unsigned* Num, int Width, int Height, int PageWidth, int PageHeight, int* X, int* Y)
+{
+    unsigned best = *Num;
+    int bestY = 0;
+    int bestBottom = PageHeight + 1;
+
+    // Bottom-left rule, place where the new top edge is lowest
+    for(unsigned i = 0; i < *Num; i++) {
+        int y;
+
+        if(skylineFit(Line, i, Width, PageWidth, &y)
+            && y + Height < bestBottom) {
+
+            best = i;
+            bestY = y;
+            bestBottom = y + Height;
+        }
     }
 
-    memcpy(texture->pixels, Sprite->pixels, Sprite->pixelsSize);
+    if(best == *Num) {
+        return false;
+    }
 
-    texture->w = Sprite->w;
-    texture->h = Sprite->h;
+    *X = Line[best].x;
+    *Y = bestY;
 
-    for(int t = 0; t < A_TEXTURE__NUM; t++) {
-        if(texture->texture[t]) {
-            SDL_DestroyTexture(texture->texture[t]);
+    memmove(&Line[best + 1],
+            &Line[best],
+            (*Num - best) * sizeof(APlatformAtlasSkyline));
+
+    Line[best] = (APlatformAtlasSkyline){*X, bestBottom, Width};
+    (*Num)++;
+
+    // Trim the segments now covered by the new one
+    const int end = *X + Width;
+
+    for(unsigned i = best + 1; i < *Num && Line[i].x < end; ) {
+        if(Line[i].x + Line[i].w > end) {
+            Line[i].w -= end - Line[i].x;
+            Line[i].x = end;
+
+            break;
         }
 
-        switch(t) {
-            case A_TEXTURE__NORMAL: {
-                for(int i = width * height; i--; ) {
-                    if(Sprite->pixels[i] != a_sprite__colorKey) {
-                        // Set full alpha for non-transparent pixel
-                        texture->pixels[i] |=
-                            (APixel)A__PIXEL_MASK_ALPHA << A__PIXEL_SHIFT_ALPHA;
-                    }
-                }
-            } break;
-
-            case A_TEXTURE__COLORMOD_BITMAP: {
-                for(int i = width * height; i--; ) {
-                    if(Sprite->pixels[i] == a_sprite__colorKey) {
-                        // Set full color for transparent pixel
-                        texture->pixels[i] |= a_pixel_fromHex(0xffffff);
-                    }
-                }
-            } break;
-
-            case A_TEXTURE__COLORMOD_FLAT: {
-                for(int i = width * height; i--;) {
-                    if(Sprite->pixels[i] != a_sprite__colorKey) {
-                        // Set full color for non-transparent pixel
-                        texture->pixels[i] |= a_pixel_fromHex(0xffffff);
-                    }
-                }
-            } break;
+        memmove(&Line[i],
+                &Line[i + 1],
+                (*Num - i - 1) * sizeof(APlatformAtlasSkyline));
+
+        (*Num)--;
+    }
+
+    // Merge neighbors at the same height
+    for(unsigned i = 0; i + 1 < *Num; ) {
+        if(Line[i].y == Line[i + 1].y) {
+            Line[i].w += Line[i + 1].w;
+
+            memmove(&Line[i + 1],
+                    &Line[i + 2],
+                    (*Num - i - 2) * sizeof(APlatformAtlasSkyline));
+
+            (*Num)--;
+        } else {
+            i++;
         }
+    }
+
+    return true;
+}
+
+static int atlasCompare(const APlatformTexture* A, const APlatformTexture* B)
+{
+    return A->h != B->h ? B->h - A->h : B->w - A->w;
+}
 
-        SDL_Texture* tex = SDL_CreateTexture(a__sdlRenderer,
-                                             A_SDL__PIXEL_FORMAT,
-                                             SDL_TEXTUREACCESS_TARGET,
-                                             width,
-                                             height);
-        if(tex == NULL) {
-            A__FATAL("SDL_CreateTexture: %s", SDL_GetError());
+static void atlasPack(void)
+{
+    unsigned num = a_list_sizeGet(g_atlas.pending);
+
+    if(num == 0) {
+        return;
+    }
+
+    // Tallest first packs tighter on a skyline
+    a_list_sort(g_atlas.pending, (AListCompare*)atlasCompare);
+
+    APlatformTexture** textures =
+        (APlatformTexture**)a_list_toArray(g_atlas.pending);
+
+    a_list_clear(g_atlas.pending);
+
+    APlatformAtlasSkyline* line =
+        a_mem_malloc((num + 1) * sizeof(APlatformAtlasSkyline));
+
+    for(unsigned left = num; left > 0; ) {
+        int area = 0;
+        int widest = 0;
+
+        for(unsigned t = 0; t < num; t++) {
+            const APlatformTexture* tex = textures[t];
+
+            if(tex->page == NULL) {
+                // Leave a 1px gap between neighbors
+                area += (tex->w + 1) * (tex->h + 1);
+                widest = a_math_max(widest, tex->w + 1);
+            }
         }
 
-        if(SDL_UpdateTexture(
-            tex, NULL, texture->pixels, width * (int)sizeof(APixel)) < 0) {
+        int side = 32;
 
-            A__FATAL("SDL_UpdateTexture: %s", SDL_GetError());
+        while(side < A__ATLAS_SIZE && (side * side < area || side < widest)) {
+            side *= 2;
         }
 
-        if(SDL_SetTextureBlendMode(tex, SDL_BLENDMODE_BLEND) < 0) {
-            a_out__error("SDL_SetTextureBlendMode: %s", SDL_GetError());
+        APlatformAtlasPage* page = a_mem_zalloc(sizeof(APlatformAtlasPage));
+        unsigned lineNum = 1;
+
+        page->textures = a_list_new();
+        page->w = side;
+        line[0] = (APlatformAtlasSkyline){0, 0, side};
+
+        for(unsigned t = 0; t < num; t++) {
+            APlatformTexture* tex = textures[t];
+
+            if(tex->page == NULL && skylineAdd(line,
+                                               &lineNum,
+                                               tex->w + 1,
+                                               tex->h + 1,
+                                               side,
+                                               A__ATLAS_SIZE,
+                                               &tex->x,
+                                               &tex->y)) {
+
+                tex->page = page;
+                tex->node = a_list_addLast(page->textures, tex);
+                page->h = a_math_max(page->h, tex->y + tex->h);
+                left--;
+            }
         }
 
-        texture->texture[t] = tex;
+    }
+
+    a_mem_free(line);
+    a_mem_free(textures);
+}
+
+void a_platform__textureAtlasBegin(void)
+{
+    g_atlas.depth++;
+}
+
+void a_platform__textureAtlasEnd(void)
+{
+    if(--g_atlas.depth == 0) {
+        atlasPack();
+    }
+}
+
+static SDL_Texture* textureGet(APlatformTexture* Texture, APlatformTextureVersion Version)
+{
+    if(Texture->node && Texture->page == NULL) {
+        atlasPack();
+    }
+
+    APlatformAtlasPage* page = Texture->page;
+    SDL_Texture** textures = page ? page->texture : Texture->texture;
+
+    if(textures[Version] || Texture->spr == NULL) {
+        return textures[Version] ? textures[Version]
+                                 : textures[A_TEXTURE__NORMAL];
+    }
+
+    if(page) {
+        APixel* buffer = a_mem_zalloc(
+                            (size_t)(page->w * page->h) * sizeof(APixel));
+
+        A_LIST_ITERATE(page->textures, const APlatformTexture*, t) {
+            texturePixelsMake(
+                t, Version, buffer + t->y * page->w + t->x, page->w);
+        }
+
+        textures[Version] = sdlTextureNew(
+                                page->w,
+                                page->h,
+                                SDL_TEXTUREACCESS_STATIC,
+                                buffer);
+
+        a_mem_free(buffer);
+    } else {
+        APixel* buffer = a_mem_malloc(
+                            (size_t)(Texture->w * Texture->h) * sizeof(APixel));
+
+        texturePixelsMake(Texture, Version, buffer, Texture->w);
+
+        textures[Version] = sdlTextureNew(
+                                Texture->w,
+                                Texture->h,
+                                SDL_TEXTUREACCESS_TARGET,
+                                buffer);
+
+        a_mem_free(buffer);
+    }
+
+    return textures[Version];
+}
+
+APlatformTexture* a_platform__textureNewScreen(int Width, int Height)
+{
+    APlatformTexture* screen = a_mem_zalloc(sizeof(APlatformTexture));
+
+    screen->w = Width;
+    screen->h = Height;
+
+    screen->texture[A_TEXTURE__NORMAL] = sdlTextureNew(
+                                            Width,
+                                            Height,
+                                            SDL_TEXTUREACCESS_TARGET,
+                                            NULL);
+
+    return screen;
+}
+
+APlatformTexture* a_platform__textureNewSprite(const ASprite* Sprite)
+{
+    APlatformTexture* texture = Sprite->texture;
+
+    a_platform_sdl_render__flush();
+
+    if(texture == NULL) {
+        texture = a_mem_zalloc(sizeof(APlatformTexture));
+    } else {
+        textureTexturesFree(texture);
+    }
+
+    texture->spr = Sprite;
+    texture->w = Sprite->w;
+    texture->h = Sprite->h;
+
+    // Texture versions are made on first use from the sprite's pixels
+    if(g_atlas.depth > 0
+        && texture->w <= A__ATLAS_SPRITE_MAX
+        && texture->h <= A__ATLAS_SPRITE_MAX) {
+
+        texture->node = a_list_addLast(g_atlas.pending, texture);
     }
 
     return texture;
@@ -450,14 +1149,11 @@ void a_platform__textureFree(APlatformTexture* Texture)
         return;
     }
 
-    for(int t = A_TEXTURE__NUM; t--; ) {
-        if(Texture->texture[t]) {
-            SDL_DestroyTexture(Texture->texture[t]);
-        }
-    }
+    a_platform_sdl_render__flush();
 
-    free(Texture->pixels);
-    free(Texture);
+    textureTexturesFree(Texture);
+
+    a_mem_free(Texture);
 }
 
 void a_platform__textureBlit(const APlatformTexture* Texture, int X, int Y, bool FillFlat)
@@ -474,34 +1170,19 @@ void a_platform__textureBlit(const APlatformTexture* Texture, int X, int Y, bool
 
 void a_platform__textureBlitEx(const APlatformTexture* Texture, int X, int Y, AFix Scale, unsigned Angle, int CenterX, int CenterY, bool FillFlat)
 {
-    SDL_Texture* tex;
+    APlatformTextureVersion version;
     SDL_BlendMode blend = pixelBlendToSdlBlend();
 
     if(FillFlat) {
-        tex = Texture->texture[A_TEXTURE__COLORMOD_FLAT];
+        version = A_TEXTURE__COLORMOD_FLAT;
     } else if(blend == SDL_BLENDMODE_MOD) {
-        tex = Texture->texture[A_TEXTURE__COLORMOD_BITMAP];
+        version = A_TEXTURE__COLORMOD_BITMAP;
     } else {
-        tex = Texture->texture[A_TEXTURE__NORMAL];
-    }
-
-    if(SDL_SetTextureBlendMode(tex, blend) < 0) {
-        a_out__error("SDL_SetTextureBlendMode: %s", SDL_GetError());
+        version = A_TEXTURE__NORMAL;
     }
 
-    if(SDL_SetTextureAlphaMod(tex, pixelAlphaToSdlAlpha()) < 0) {
-        a_out__error("SDL_SetTextureAlphaMod: %s", SDL_GetError());
-    }
-
-    if(FillFlat) {
-        if(SDL_SetTextureColorMod(tex,
-                                  (uint8_t)a_pixel__state.red,
-                                  (uint8_t)a_pixel__state.green,
-                                  (uint8_t)a_pixel__state.blue) < 0) {
-
-            a_out__error("SDL_SetTextureColorMod: %s", SDL_GetError());
-        }
-    }
+    // The texture versions are a cache, creating one is not a visible change
+    SDL_Texture* tex = textureGet((APlatformTexture*)Texture, version);
 
     SDL_Point center = {a_fix_toInt((Texture->w / 2 + CenterX) * Scale),
                         a_fix_toInt((Texture->h / 2 + CenterY) * Scale)};
@@ -511,28 +1192,108 @@ void a_platform__textureBlitEx(const APlatformTexture* Texture, int X, int Y, AF
                      a_fix_toInt(Texture->w * Scale),
                      a_fix_toInt(Texture->h * Scale)};
 
-    if(SDL_RenderCopyEx(a__sdlRenderer,
-                        tex,
-                        NULL,
-                        &dest,
-                        360 - 360 * Angle / A_FIX_ANGLES_NUM,
-                        &center,
-                        SDL_FLIP_NONE) < 0) {
+    #if A__BATCH
+        // Alpha and color mod go in the vertex colors, so consecutive blits
+        // only break a batch when the texture or blend mode changes
+        SDL_Color color = {0xff, 0xff, 0xff, pixelAlphaToSdlAlpha()};
 
-        a_out__error("SDL_RenderCopyEx: %s", SDL_GetError());
-    }
+        if(FillFlat) {
+            color.r = (uint8_t)a_pixel__state.red;
+            color.g = (uint8_t)a_pixel__state.green;
+            color.b = (uint8_t)a_pixel__state.blue;
+        }
 
-    if(FillFlat) {
-        if(SDL_SetTextureColorMod(tex, 0xff, 0xff, 0xff) < 0) {
-            a_out__error("SDL_SetTextureColorMod: %s", SDL_GetError());
+        SDL_FPoint corners[4];
+        float x1 = (float)-center.x;
+        float y1 = (float)-center.y;
+        float x2 = x1 + (float)dest.w;
+        float y2 = y1 + (float)dest.h;
+
+        if(Angle == 0) {
+            corners[0] = (SDL_FPoint){x1, y1};
+            corners[1] = (SDL_FPoint){x2, y1};
+            corners[2] = (SDL_FPoint){x2, y2};
+            corners[3] = (SDL_FPoint){x1, y2};
+        } else {
+            float sinA = a_fix_toFloat(a_fix_sin(Angle));
+            float cosA = a_fix_toFloat(a_fix_cos(Angle));
+
+            corners[0] = (SDL_FPoint){x1 * cosA + y1 * sinA,
+                                      y1 * cosA - x1 * sinA};
+            corners[1] = (SDL_FPoint){x2 * cosA + y1 * sinA,
+                                      y1 * cosA - x2 * sinA};
+            corners[2] = (SDL_FPoint){x2 * cosA + y2 * sinA,
+                                      y2 * cosA - x2 * sinA};
+            corners[3] = (SDL_FPoint){x1 * cosA + y2 * sinA,
+                                      y2 * cosA - x1 * sinA};
         }
-    }
+
+        for(int c = 0; c < 4; c++) {
+            corners[c].x += (float)X;
+            corners[c].y += (float)Y;
+        }
+
+        // Sprites on an atlas page only sample their own area
+        float texW = (float)(Texture->page ? Texture->page->w : Texture->w);
+        float texH = (float)(Texture->page ? Texture->page->h : Texture->h);
+
+        SDL_FPoint uv1 = {(float)Texture->x / texW,
+                          (float)Texture->y / texH};
+        SDL_FPoint uv2 = {(float)(Texture->x + Texture->w) / texW,
+                          (float)(Texture->y + Texture->h) / texH};
+
+        batchQuadAdd(tex, blend, corners, uv1, uv2, color);
+    #else
+        if(SDL_SetTextureBlendMode(tex, blend) < 0) {
+            a_out__error("SDL_SetTextureBlendMode: %s", SDL_GetError());
+        }
+
+        if(SDL_SetTextureAlphaMod(tex, pixelAlphaToSdlAlpha()) < 0) {
+            a_out__error("SDL_SetTextureAlphaMod: %s", SDL_GetError());
+        }
+
+        if(FillFlat) {
+            if(SDL_SetTextureColorMod(tex,
+                                      (uint8_t)a_pixel__state.red,
+                                      (uint8_t)a_pixel__state.green,
+                                      (uint8_t)a_pixel__state.blue) < 0) {
+
+                a_out__error("SDL_SetTextureColorMod: %s", SDL_GetError());
+            }
+        }
+
+        SDL_Rect src = {Texture->x, Texture->y, Texture->w, Texture->h};
+
+        if(SDL_RenderCopyEx(a__sdlRenderer,
+                            tex,
+                            &src,
+                            &dest,
+                            360 - 360 * Angle / A_FIX_ANGLES_NUM,
+                            &center,
+                            SDL_FLIP_NONE) < 0) {
+
+            a_out__error("SDL_RenderCopyEx: %s", SDL_GetError());
+        }
+
+        if(FillFlat) {
+            if(SDL_SetTextureColorMod(tex, 0xff, 0xff, 0xff) < 0) {
+                a_out__error("SDL_SetTextureColorMod: %s", SDL_GetError());
+            }
+        }
+    #endif
 }
 
 void a_platform__renderTargetSet(APlatformTexture* Texture)
 {
+    a_platform_sdl_render__flush();
+
+    if(Texture->node) {
+        // Sprites that get drawn on need their own textures
+        textureTexturesFree(Texture);
+    }
+
     if(SDL_SetRenderTarget(
-        a__sdlRenderer, Texture->texture[A_TEXTURE__NORMAL]) < 0) {
+        a__sdlRenderer, textureGet(Texture, A_TEXTURE__NORMAL)) < 0) {
 
         A__FATAL("SDL_SetRenderTarget: %s", SDL_GetError());
     }
@@ -540,6 +1301,8 @@ void a_platform__renderTargetSet(APlatformTexture* Texture)
 
 void a_platform__renderTargetPixelsGet(APixel* Pixels, int Width)
 {
+    a_platform_sdl_render__flush();
+
     // Unreliable on texture targets
     if(SDL_RenderReadPixels(a__sdlRenderer,
                             NULL,
@@ -553,6 +1316,8 @@ void a_platform__renderTargetPixelsGet(APixel* Pixels, int Width)
 
 void a_platform__renderTargetClipSet(int X, int Y, int Width, int Height)
 {
+    a_platform_sdl_render__flush();
+
     SDL_Rect area = {X, Y, Width, Height};
 
     if(SDL_RenderSetClipRect(a__sdlRenderer, &area) < 0) {
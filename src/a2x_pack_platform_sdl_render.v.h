@@ -19,3 +19,10 @@
 #pragma once
 
 #include "a2x_pack_platform_sdl_render.p.h"
+
+#if A_CONFIG_LIB_RENDER_SDL
+    extern void a_platform_sdl_render__init(void);
+    extern void a_platform_sdl_render__uninit(void);
+
+    extern void a_platform_sdl_render__flush(void);
+#endif
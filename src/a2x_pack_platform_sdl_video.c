@@ -23,6 +23,8 @@
 
 #include "a2x_pack_main.v.h"
 #include "a2x_pack_out.v.h"
+#include "a2x_pack_pixel_simd.v.h"
+#include "a2x_pack_platform_sdl_render.v.h"
 #include "a2x_pack_platform_wiz.v.h"
 #include "a2x_pack_screen.v.h"
 #include "a2x_pack_str.v.h"
@@ -55,6 +57,10 @@ void a_platform_sdl_video__init(void)
     if(SDL_InitSubSystem(SDL_INIT_VIDEO) != 0) {
         A__FATAL("SDL_InitSubSystem: %s", SDL_GetError());
     }
+
+    #if A_CONFIG_LIB_RENDER_SDL
+        a_platform_sdl_render__init();
+    #endif
 }
 
 void a_platform_sdl_video__uninit(void)
@@ -68,6 +74,8 @@ void a_platform_sdl_video__uninit(void)
     #elif A_CONFIG_LIB_SDL == 2
         #if A_CONFIG_LIB_RENDER_SOFTWARE
             SDL_DestroyTexture(g_sdlTexture);
+        #else
+            a_platform_sdl_render__uninit();
         #endif
 
         SDL_DestroyRenderer(a__sdlRenderer);
@@ -222,14 +230,108 @@ void a_platform__screenInit(int Width, int Height)
     #endif
 }
 
+#if A_CONFIG_LIB_SDL == 1 && A_CONFIG_SCREEN_WIZ_FIX
+#define A__SCREEN_W A_CONFIG_SCREEN_HARDWARE_WIDTH
+#define A__SCREEN_H A_CONFIG_SCREEN_HARDWARE_HEIGHT
+#define A__ROTATE_BLOCK 16
+
+// Rotates in square blocks, so the few source lines and destination columns
+// that a block touches stay in the Wiz's small data cache
+static void rotateArea(APixel* Dst, const APixel* Src, int X, int Y, int W, int H)
+{
+    for(int by = Y; by < Y + H; by += A__ROTATE_BLOCK) {
+        const int by2 = a_math_min(by + A__ROTATE_BLOCK, Y + H);
+
+        for(int bx = X; bx < X + W; bx += A__ROTATE_BLOCK) {
+            const int bx2 = a_math_min(bx + A__ROTATE_BLOCK, X + W);
+
+            for(int x = bx; x < bx2; x++) {
+                // Landscape x,y goes to portrait (W - 1 - x) * H + y
+                const APixel* src = Src + by * A__SCREEN_W + x;
+                APixel* dst = Dst + (A__SCREEN_W - 1 - x) * A__SCREEN_H + by;
+                int y = by;
+
+                #if A_CONFIG_SCREEN_BPP == 16 && defined(__BYTE_ORDER__) \
+                    && __BYTE_ORDER__ == __ORDER_LITTLE_ENDIAN__
+                    if(y & 1) {
+                        *dst++ = *src;
+                        src += A__SCREEN_W;
+                        y++;
+                    }
+
+                    // Even y is word-aligned, store two pixels at a time
+                    for( ; y < by2 - 1; y += 2) {
+                        const uint32_t pair = (uint32_t)src[0]
+                                                | (uint32_t)src[A__SCREEN_W] << 16;
+
+                        memcpy(dst, &pair, sizeof(pair));
+
+                        dst += 2;
+                        src += 2 * A__SCREEN_W;
+                    }
+                #endif
+
+                for( ; y < by2; y++) {
+                    *dst++ = *src;
+                    src += A__SCREEN_W;
+                }
+            }
+        }
+    }
+}
+#endif
+
+#if A_CONFIG_LIB_SDL == 1 && A_CONFIG_SCREEN_ALLOCATE \
+    && A_CONFIG_SCREEN_ZOOM_SCALE2X
+// Doubles pixels like zoom 2, but rounds off the corners of diagonal edges
+static void scale2x(APixel* Dst, ptrdiff_t Pitch, int X, int Y, int W, int H)
+{
+    const int width = a__screen.width;
+    const int height = a__screen.height;
+
+    for(int y = Y; y < Y + H; y++, Dst += 2 * Pitch) {
+        const APixel* row = a__screen.pixels + y * width;
+        const APixel* above = y > 0 ? row - width : row;
+        const APixel* below = y < height - 1 ? row + width : row;
+        APixel* dst = Dst;
+        APixel* dst2 = Dst + Pitch;
+
+        for(int x = X; x < X + W; x++, dst += 2, dst2 += 2) {
+            const APixel p = row[x];
+            const APixel a = above[x];
+            const APixel b = below[x];
+            const APixel l = x > 0 ? row[x - 1] : p;
+            const APixel r = x < width - 1 ? row[x + 1] : p;
+
+            if(a != b && l != r) {
+                dst[0] = l == a ? l : p;
+                dst[1] = a == r ? r : p;
+                dst2[0] = l == b ? l : p;
+                dst2[1] = b == r ? r : p;
+            } else {
+                dst[0] = p;
+                dst[1] = p;
+                dst2[0] = p;
+                dst2[1] = p;
+            }
+        }
+    }
+}
+#endif
+
 void a_platform__screenShow(void)
 {
     #if A_CONFIG_LIB_SDL == 1
+        #if A_CONFIG_SCREEN_ALLOCATE
+            unsigned num;
+            const AScreenRect* dirty = a_screen__dirtyGet(&num);
+        #endif
+
         #if A_CONFIG_SCREEN_WIZ_FIX
-            // The Wiz screen has diagonal tearing in landscape mode. As a slow
-            // but simple workaround, the screen is set to portrait mode where
-            // 320,0 is top-left and 0,240 is bottom-right, and the game's
-            // landscape pixel buffer is rotated to this format every frame.
+            // The Wiz screen has diagonal tearing in landscape mode. As a
+            // workaround, the screen is set to portrait mode where 320,0 is
+            // top-left and 0,240 is bottom-right, and the game's landscape
+            // pixel buffer's dirty areas are rotated to this format.
 
             if(SDL_MUSTLOCK(g_sdlScreen)) {
                 if(SDL_LockSurface(g_sdlScreen) < 0) {
@@ -237,27 +339,28 @@ void a_platform__screenShow(void)
                 }
             }
 
-            #define A__SCREEN_TOTAL (A_CONFIG_SCREEN_HARDWARE_WIDTH \
-                                        * A_CONFIG_SCREEN_HARDWARE_HEIGHT)
-
-            APixel* dst = (APixel*)g_sdlScreen->pixels + A__SCREEN_TOTAL;
-            const APixel* src = a__screen.pixels;
-
-            for(int i = A_CONFIG_SCREEN_HARDWARE_HEIGHT;
-                i--;
-                dst += A__SCREEN_TOTAL + 1) {
-
-                for(int j = A_CONFIG_SCREEN_HARDWARE_WIDTH; j--; ) {
-                    dst -= A_CONFIG_SCREEN_HARDWARE_HEIGHT;
-                    *dst = *src++;
-                }
+            for(unsigned r = 0; r < num; r++) {
+                rotateArea((APixel*)g_sdlScreen->pixels,
+                           a__screen.pixels,
+                           dirty[r].x,
+                           dirty[r].y,
+                           dirty[r].w,
+                           dirty[r].h);
             }
 
             if(SDL_MUSTLOCK(g_sdlScreen)) {
                 SDL_UnlockSurface(g_sdlScreen);
             }
 
-            SDL_Flip(g_sdlScreen);
+            for(unsigned r = 0; r < num; r++) {
+                const AScreenRect* d = &dirty[r];
+
+                SDL_UpdateRect(g_sdlScreen,
+                               d->y,
+                               A__SCREEN_W - d->x - d->w,
+                               (unsigned)d->h,
+                               (unsigned)d->w);
+            }
 
             return;
         #endif
@@ -269,40 +372,60 @@ void a_platform__screenShow(void)
                 }
             }
 
-            int zoom = a_screen__zoomGet();
+            int zoom = a_math_max(a_screen__zoomGet(), 1);
+            int realW = a_math_min(g_sdlScreen->w / zoom, a__screen.width);
+            int realH = a_math_min(g_sdlScreen->h / zoom, a__screen.height);
+            ptrdiff_t pitch = g_sdlScreen->pitch / (int)sizeof(APixel);
+
+            SDL_Rect areas[A__SCREEN_DIRTY_NUM];
+
+            for(unsigned r = 0; r < num; r++) {
+                int x = dirty[r].x;
+                int y = dirty[r].y;
+                int w = dirty[r].w;
+                int h = dirty[r].h;
+
+                #if A_CONFIG_SCREEN_ZOOM_SCALE2X
+                    if(zoom == 2) {
+                        // Pixels next to the dirty area depend on it too
+                        x = a_math_max(0, x - 1);
+                        y = a_math_max(0, y - 1);
+                        w = dirty[r].x + dirty[r].w + 1 - x;
+                        h = dirty[r].y + dirty[r].h + 1 - y;
+                    }
+                #endif
 
-            if(zoom <= 1) {
-                memcpy(g_sdlScreen->pixels,
-                       a__screen.pixels,
-                       a__screen.pixelsSize);
-            } else {
-                int realH = g_sdlScreen->h / zoom;
-                int realW = g_sdlScreen->w / zoom;
+                w = a_math_max(0, a_math_min(w, realW - x));
+                h = a_math_max(0, a_math_min(h, realH - y));
 
-                APixel* dst = (APixel*)g_sdlScreen->pixels;
-                const APixel* srcStart = a__screen.pixels;
+                areas[r] = (SDL_Rect){(Sint16)(x * zoom),
+                                      (Sint16)(y * zoom),
+                                      (Uint16)(w * zoom),
+                                      (Uint16)(h * zoom)};
 
-                ptrdiff_t dstRemainderInc =
-                    (int)g_sdlScreen->pitch / (int)sizeof(APixel)
-                        - g_sdlScreen->w;
-                ptrdiff_t srcStartInc = g_sdlScreen->w / zoom;
+                const APixel* src = a__screen.pixels + y * a__screen.width + x;
+                APixel* dst = (APixel*)g_sdlScreen->pixels
+                                + y * zoom * pitch + x * zoom;
 
-                for(int y = realH; y--; ) {
-                    for(int z = zoom; z--; ) {
-                        const APixel* src = srcStart;
+                #if A_CONFIG_SCREEN_ZOOM_SCALE2X
+                    if(zoom == 2) {
+                        scale2x(dst, pitch, x, y, w, h);
+                        continue;
+                    }
+                #endif
 
-                        for(int x = realW; x--; ) {
-                            for(int z = zoom; z--; ) {
-                                *dst++ = *src;
-                            }
+                // Zoom each line once, then copy it to the rest of its rows
+                const size_t lineSize = (size_t)(w * zoom) * sizeof(APixel);
 
-                            src++;
-                        }
+                for(int i = h; i--; src += a__screen.width) {
+                    a_pixel__zoom(dst, src, w, zoom);
 
-                        dst += dstRemainderInc;
+                    for(int z = zoom - 1; z--; ) {
+                        memcpy(dst + pitch, dst, lineSize);
+                        dst += pitch;
                     }
 
-                    srcStart += srcStartInc;
+                    dst += pitch;
                 }
             }
 
@@ -310,7 +433,7 @@ void a_platform__screenShow(void)
                 SDL_UnlockSurface(g_sdlScreen);
             }
 
-            SDL_Flip(g_sdlScreen);
+            SDL_UpdateRects(g_sdlScreen, (int)num, areas);
         #else // !A_CONFIG_SCREEN_ALLOCATE
             if(SDL_MUSTLOCK(g_sdlScreen)) {
                 SDL_UnlockSurface(g_sdlScreen);
@@ -328,6 +451,8 @@ void a_platform__screenShow(void)
         #endif
     #elif A_CONFIG_LIB_SDL == 2
         #if A_CONFIG_LIB_RENDER_SDL
+            a_platform_sdl_render__flush();
+
             if(SDL_SetRenderTarget(a__sdlRenderer, NULL) < 0) {
                 A__FATAL("SDL_SetRenderTarget: %s", SDL_GetError());
             }
@@ -349,12 +474,22 @@ void a_platform__screenShow(void)
         a_platform__renderClear();
 
         #if A_CONFIG_LIB_RENDER_SOFTWARE
-            if(SDL_UpdateTexture(g_sdlTexture,
-                                 NULL,
-                                 a__screen.pixels,
-                                 a__screen.width * (int)sizeof(APixel)) < 0) {
+            unsigned num;
+            const AScreenRect* dirty = a_screen__dirtyGet(&num);
 
-                A__FATAL("SDL_UpdateTexture: %s", SDL_GetError());
+            for(unsigned r = 0; r < num; r++) {
+                const AScreenRect* d = &dirty[r];
+                SDL_Rect area = {d->x, d->y, d->w, d->h};
+
+                if(SDL_UpdateTexture(g_sdlTexture,
+                                     &area,
+                                     a__screen.pixels
+                                        + d->y * a__screen.width + d->x,
+                                     a__screen.width * (int)sizeof(APixel))
+                                        < 0) {
+
+                    A__FATAL("SDL_UpdateTexture: %s", SDL_GetError());
+                }
             }
 
             if(SDL_RenderCopy(a__sdlRenderer, g_sdlTexture, NULL, NULL) < 0) {
@@ -382,6 +517,10 @@ void a_platform__screenShow(void)
 #if A_CONFIG_LIB_SDL == 2
 void a_platform__renderClear(void)
 {
+    #if A_CONFIG_LIB_RENDER_SDL
+        a_platform_sdl_render__flush();
+    #endif
+
     if(SDL_RenderClear(a__sdlRenderer) < 0) {
         a_out__error("SDL_RenderClear: %s", SDL_GetError());
     }
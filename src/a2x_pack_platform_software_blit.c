@@ -20,24 +20,131 @@
 
 #if A_CONFIG_LIB_RENDER_SOFTWARE
 #include "a2x_pack_mem.v.h"
+#include "a2x_pack_palette.v.h"
 #include "a2x_pack_pixel.v.h"
+#include "a2x_pack_pixel_simd.v.h"
+#include "a2x_pack_platform_software_tiles.v.h"
 #include "a2x_pack_screen.v.h"
 
+typedef enum {
+    A_BLIT__BLOCK,
+    A_BLIT__KEYED,
+    A_BLIT__ALPHA,
+    A_BLIT__NUM
+} ABlitMode;
+
+typedef enum {
+    A_BLIT__ALPHA_CLEAR,
+    A_BLIT__ALPHA_OPAQUE,
+    A_BLIT__ALPHA_PARTIAL
+} ABlitAlpha;
+
 struct APlatformTexture {
     const ASprite* spr;
-    bool colorKeyed;
-    size_t spansSize;
-    unsigned spans[];
+    ABlitMode mode;
+    int dirtyY, dirtyY2; // lines drawn on since the spans were made
+    size_t bufferSize;
+    uint32_t* lines; // [h + 1] offsets of each graphic line's spans
+    uint16_t* spans; // follows lines in the same buffer
 };
 
+typedef struct {
+    int x, y, x2, y2; // clipped screen area to scan, x2 and y2 exclusive
+    AFix u, v; // sprite coords sampled at the center of pixel (x, y)
+    AFix uDx, vDx; // sprite coords step per screen column
+    AFix uDy, vDy; // sprite coords step per screen row
+} ABlitEx;
+
 typedef void (*ABlitter)(const APlatformTexture* Sprite, int X, int Y);
+typedef void (*ABlitterEx)(const APlatformTexture* Sprite, const ABlitEx* Ex);
+
+// [Indexed][Blend][Fill][Mode][Clip], indexed sprites have no alpha mode
+static ABlitter g_blitters[2][A_PIXEL_BLEND_NUM][2][A_BLIT__NUM][2];
+
+// [Indexed][Blend][Fill][Mode]
+static ABlitterEx g_blittersEx[2][A_PIXEL_BLEND_NUM][2][A_BLIT__NUM];
+
+static inline int64_t floorDiv(int64_t Num, int64_t Den)
+{
+    return Num >= 0 ? Num / Den : -((-Num + Den - 1) / Den);
+}
+
+static inline int64_t ceilDiv(int64_t Num, int64_t Den)
+{
+    return -floorDiv(-Num, Den);
+}
+
+// Narrow [Start, End) to the steps for which 0 <= C + Step * D <= Max
+static void exSpanClip(AFix C, AFix D, AFix Max, int* Start, int* End)
+{
+    int64_t lo, hi;
+
+    if(D > 0) {
+        lo = ceilDiv(-(int64_t)C, D);
+        hi = floorDiv((int64_t)Max - C, D);
+    } else if(D < 0) {
+        lo = ceilDiv((int64_t)C - Max, -(int64_t)D);
+        hi = floorDiv(C, -(int64_t)D);
+    } else if(C >= 0 && C <= Max) {
+        return;
+    } else {
+        *End = *Start;
+        return;
+    }
+
+    if(lo > *Start) {
+        *Start = lo < *End ? (int)lo : *End;
+    }
+
+    if(hi + 1 < *End) {
+        *End = hi + 1 > *Start ? (int)(hi + 1) : *Start;
+    }
+}
+
+// Find the run of screen pixels on a row that map inside the sprite
+static inline bool exSpan(const ABlitEx* Ex, int W, int H, AFix U, AFix V, int* Start, int* End)
+{
+    *Start = 0;
+    *End = Ex->x2 - Ex->x;
+
+    exSpanClip(U, Ex->uDx, a_fix_fromInt(W) - 1, Start, End);
+    exSpanClip(V, Ex->vDx, a_fix_fromInt(H) - 1, Start, End);
+
+    return *Start < *End;
+}
+
+static inline ABlitAlpha alphaState(APixel Pixel, uint8_t Alpha)
+{
+    if(Pixel == a_sprite__colorKey || Alpha == 0) {
+        return A_BLIT__ALPHA_CLEAR;
+    }
+
+    return Alpha == 255 ? A_BLIT__ALPHA_OPAQUE : A_BLIT__ALPHA_PARTIAL;
+}
+
+// Mix an already blended copy of Dst back in by the sprite pixel's alpha
+static inline void alphaMix(APixel* Dst, APixel Blended, unsigned Alpha)
+{
+    int r, g, b;
+    a_pixel_toRgb(Blended, &r, &g, &b);
+
+    // Sprite alpha is out of 255, blend alpha is out of 256
+    Alpha += Alpha >> 7;
+
+    a_pixel__rgba(Dst, r, g, b, (int)Alpha);
+}
 
-// [Blend][Fill][ColorKey][Clip]
-static ABlitter g_blitters[A_PIXEL_BLEND_NUM][2][2][2];
+// Indexed sprites draw with the current palette if one is set, else their own
+static inline const APixel* blitPalette(const ASprite* Sprite)
+{
+    const APalette* p = a_pixel__state.palette;
 
-#define A__FUNC_NAME_EXPAND2(Blend, Fill, ColorKey, Clip) a_blit__##Blend##_##Fill##_##ColorKey##_##Clip
-#define A__FUNC_NAME_EXPAND(Blend, Fill, ColorKey, Clip) A__FUNC_NAME_EXPAND2(Blend, Fill, ColorKey, Clip)
-#define A__FUNC_NAME(ColorKey, Clip) A__FUNC_NAME_EXPAND(A__BLEND, A__FILL, ColorKey, Clip)
+    return (p ? p : Sprite->palette)->colors;
+}
+
+#define A__FUNC_NAME_EXPAND2(Blend, Fill, Source, ColorKey, Clip) a_blit__##Blend##_##Fill##_##Source##_##ColorKey##_##Clip
+#define A__FUNC_NAME_EXPAND(Blend, Fill, Source, ColorKey, Clip) A__FUNC_NAME_EXPAND2(Blend, Fill, Source, ColorKey, Clip)
+#define A__FUNC_NAME(ColorKey, Clip) A__FUNC_NAME_EXPAND(A__BLEND, A__FILL, A__SRC, ColorKey, Clip)
 
 #define A__PIXEL_DRAW_EXPAND2(Blend) a_pixel__##Blend
 #define A__PIXEL_DRAW_EXPAND(Blend, Params) A__PIXEL_DRAW_EXPAND2(Blend)(Params)
@@ -47,8 +154,11 @@ static ABlitter g_blitters[A_PIXEL_BLEND_NUM][2][2][2];
 #define A__FILL data
 #define A__BLEND_SETUP
 #define A__PIXEL_SETUP
-#define A__PIXEL_PARAMS , *src
-#include "a2x_pack_platform_software_blit.inc.c"
+#define A__PIXEL_PARAMS , A__SRC_PIXEL
+#define A__SPAN_DATA(Dst, Src, Len) \
+    memcpy(Dst, Src, (size_t)(Len) * sizeof(APixel))
+#define A__SPAN_NATIVE
+#include "a2x_pack_platform_software_blit_sources.inc.c"
 
 #define A__BLEND plain
 #define A__FILL flat
@@ -56,19 +166,22 @@ static ABlitter g_blitters[A_PIXEL_BLEND_NUM][2][2][2];
     const APixel color = a_pixel__state.pixel;
 #define A__PIXEL_SETUP
 #define A__PIXEL_PARAMS , color
-#include "a2x_pack_platform_software_blit.inc.c"
+#define A__SPAN_FLAT(Dst, Len) a_pixel__fill(Dst, Len, color)
+#define A__SPAN_NATIVE
+#include "a2x_pack_platform_software_blit_sources.inc.c"
 
 #define A__BLEND rgba
 #define A__FILL data
 #define A__BLEND_SETUP                      \
-    int r, g, b;                            \
     const int alpha = a_pixel__state.alpha; \
     if(alpha == 0) {                        \
         return;                             \
     }
-#define A__PIXEL_SETUP a_pixel_toRgb(*src, &r, &g, &b);
+#define A__PIXEL_SETUP int r, g, b; a_pixel_toRgb(A__SRC_PIXEL, &r, &g, &b);
 #define A__PIXEL_PARAMS , r, g, b, alpha
-#include "a2x_pack_platform_software_blit.inc.c"
+#define A__SPAN_DATA(Dst, Src, Len) \
+    a_pixel__span_rgba_data(Dst, Src, Len, alpha)
+#include "a2x_pack_platform_software_blit_sources.inc.c"
 
 #define A__BLEND rgba
 #define A__FILL flat
@@ -82,14 +195,17 @@ static ABlitter g_blitters[A_PIXEL_BLEND_NUM][2][2][2];
     }
 #define A__PIXEL_SETUP
 #define A__PIXEL_PARAMS , red, green, blue, alpha
-#include "a2x_pack_platform_software_blit.inc.c"
+#define A__SPAN_FLAT(Dst, Len) \
+    a_pixel__span_rgba_flat(Dst, Len, red, green, blue, alpha)
+#include "a2x_pack_platform_software_blit_sources.inc.c"
 
 #define A__BLEND rgb25
 #define A__FILL data
-#define A__BLEND_SETUP int r, g, b;
-#define A__PIXEL_SETUP a_pixel_toRgb(*src, &r, &g, &b);
+#define A__BLEND_SETUP
+#define A__PIXEL_SETUP int r, g, b; a_pixel_toRgb(A__SRC_PIXEL, &r, &g, &b);
 #define A__PIXEL_PARAMS , r, g, b
-#include "a2x_pack_platform_software_blit.inc.c"
+#define A__SPAN_DATA(Dst, Src, Len) a_pixel__span_rgb25_data(Dst, Src, Len, 0)
+#include "a2x_pack_platform_software_blit_sources.inc.c"
 
 #define A__BLEND rgb25
 #define A__FILL flat
@@ -99,14 +215,17 @@ static ABlitter g_blitters[A_PIXEL_BLEND_NUM][2][2][2];
     const int blue = a_pixel__state.blue;
 #define A__PIXEL_SETUP
 #define A__PIXEL_PARAMS , red, green, blue
-#include "a2x_pack_platform_software_blit.inc.c"
+#define A__SPAN_FLAT(Dst, Len) \
+    a_pixel__span_rgb25_flat(Dst, Len, red, green, blue, 0)
+#include "a2x_pack_platform_software_blit_sources.inc.c"
 
 #define A__BLEND rgb50
 #define A__FILL data
-#define A__BLEND_SETUP int r, g, b;
-#define A__PIXEL_SETUP a_pixel_toRgb(*src, &r, &g, &b);
+#define A__BLEND_SETUP
+#define A__PIXEL_SETUP int r, g, b; a_pixel_toRgb(A__SRC_PIXEL, &r, &g, &b);
 #define A__PIXEL_PARAMS , r, g, b
-#include "a2x_pack_platform_software_blit.inc.c"
+#define A__SPAN_DATA(Dst, Src, Len) a_pixel__span_rgb50_data(Dst, Src, Len, 0)
+#include "a2x_pack_platform_software_blit_sources.inc.c"
 
 #define A__BLEND rgb50
 #define A__FILL flat
@@ -116,14 +235,17 @@ static ABlitter g_blitters[A_PIXEL_BLEND_NUM][2][2][2];
     const int blue = a_pixel__state.blue;
 #define A__PIXEL_SETUP
 #define A__PIXEL_PARAMS , red, green, blue
-#include "a2x_pack_platform_software_blit.inc.c"
+#define A__SPAN_FLAT(Dst, Len) \
+    a_pixel__span_rgb50_flat(Dst, Len, red, green, blue, 0)
+#include "a2x_pack_platform_software_blit_sources.inc.c"
 
 #define A__BLEND rgb75
 #define A__FILL data
-#define A__BLEND_SETUP int r, g, b;
-#define A__PIXEL_SETUP a_pixel_toRgb(*src, &r, &g, &b);
+#define A__BLEND_SETUP
+#define A__PIXEL_SETUP int r, g, b; a_pixel_toRgb(A__SRC_PIXEL, &r, &g, &b);
 #define A__PIXEL_PARAMS , r, g, b
-#include "a2x_pack_platform_software_blit.inc.c"
+#define A__SPAN_DATA(Dst, Src, Len) a_pixel__span_rgb75_data(Dst, Src, Len, 0)
+#include "a2x_pack_platform_software_blit_sources.inc.c"
 
 #define A__BLEND rgb75
 #define A__FILL flat
@@ -133,28 +255,31 @@ static ABlitter g_blitters[A_PIXEL_BLEND_NUM][2][2][2];
     const int blue = a_pixel__state.blue;
 #define A__PIXEL_SETUP
 #define A__PIXEL_PARAMS , red, green, blue
-#include "a2x_pack_platform_software_blit.inc.c"
+#define A__SPAN_FLAT(Dst, Len) \
+    a_pixel__span_rgb75_flat(Dst, Len, red, green, blue, 0)
+#include "a2x_pack_platform_software_blit_sources.inc.c"
 
 #define A__BLEND inverse
 #define A__FILL data
 #define A__BLEND_SETUP
 #define A__PIXEL_SETUP
 #define A__PIXEL_PARAMS
-#include "a2x_pack_platform_software_blit.inc.c"
+#include "a2x_pack_platform_software_blit_sources.inc.c"
 
 #define A__BLEND inverse
 #define A__FILL flat
 #define A__BLEND_SETUP
 #define A__PIXEL_SETUP
 #define A__PIXEL_PARAMS
-#include "a2x_pack_platform_software_blit.inc.c"
+#include "a2x_pack_platform_software_blit_sources.inc.c"
 
 #define A__BLEND mod
 #define A__FILL data
-#define A__BLEND_SETUP int r, g, b;
-#define A__PIXEL_SETUP a_pixel_toRgb(*src, &r, &g, &b);
+#define A__BLEND_SETUP
+#define A__PIXEL_SETUP int r, g, b; a_pixel_toRgb(A__SRC_PIXEL, &r, &g, &b);
 #define A__PIXEL_PARAMS , r, g, b
-#include "a2x_pack_platform_software_blit.inc.c"
+#define A__SPAN_DATA(Dst, Src, Len) a_pixel__span_mod_data(Dst, Src, Len, 0)
+#include "a2x_pack_platform_software_blit_sources.inc.c"
 
 #define A__BLEND mod
 #define A__FILL flat
@@ -164,14 +289,17 @@ static ABlitter g_blitters[A_PIXEL_BLEND_NUM][2][2][2];
     const int blue = a_pixel__state.blue;
 #define A__PIXEL_SETUP
 #define A__PIXEL_PARAMS , red, green, blue
-#include "a2x_pack_platform_software_blit.inc.c"
+#define A__SPAN_FLAT(Dst, Len) \
+    a_pixel__span_mod_flat(Dst, Len, red, green, blue, 0)
+#include "a2x_pack_platform_software_blit_sources.inc.c"
 
 #define A__BLEND add
 #define A__FILL data
-#define A__BLEND_SETUP int r, g, b;
-#define A__PIXEL_SETUP a_pixel_toRgb(*src, &r, &g, &b);
+#define A__BLEND_SETUP
+#define A__PIXEL_SETUP int r, g, b; a_pixel_toRgb(A__SRC_PIXEL, &r, &g, &b);
 #define A__PIXEL_PARAMS , r, g, b
-#include "a2x_pack_platform_software_blit.inc.c"
+#define A__SPAN_DATA(Dst, Src, Len) a_pixel__span_add_data(Dst, Src, Len, 0)
+#include "a2x_pack_platform_software_blit_sources.inc.c"
 
 #define A__BLEND add
 #define A__FILL flat
@@ -181,19 +309,35 @@ static ABlitter g_blitters[A_PIXEL_BLEND_NUM][2][2][2];
     const int blue = a_pixel__state.blue;
 #define A__PIXEL_SETUP
 #define A__PIXEL_PARAMS , red, green, blue
-#include "a2x_pack_platform_software_blit.inc.c"
+#define A__SPAN_FLAT(Dst, Len) \
+    a_pixel__span_add_flat(Dst, Len, red, green, blue, 0)
+#include "a2x_pack_platform_software_blit_sources.inc.c"
 
 void a_platform_software_blit__init(void)
 {
-    #define initRoutines(Index, Blend)                                    \
-        g_blitters[Index][0][0][0] = a_blit__##Blend##_data_block_noclip; \
-        g_blitters[Index][0][0][1] = a_blit__##Blend##_data_block_doclip; \
-        g_blitters[Index][0][1][0] = a_blit__##Blend##_data_keyed_noclip; \
-        g_blitters[Index][0][1][1] = a_blit__##Blend##_data_keyed_doclip; \
-        g_blitters[Index][1][0][0] = a_blit__##Blend##_flat_block_noclip; \
-        g_blitters[Index][1][0][1] = a_blit__##Blend##_flat_block_doclip; \
-        g_blitters[Index][1][1][0] = a_blit__##Blend##_flat_keyed_noclip; \
-        g_blitters[Index][1][1][1] = a_blit__##Blend##_flat_keyed_doclip;
+    #define initSource(Indexed, Index, Blend, Src)                                         \
+        g_blitters[Indexed][Index][0][0][0] = a_blit__##Blend##_data_##Src##_block_noclip; \
+        g_blitters[Indexed][Index][0][0][1] = a_blit__##Blend##_data_##Src##_block_doclip; \
+        g_blitters[Indexed][Index][0][1][0] = a_blit__##Blend##_data_##Src##_keyed_noclip; \
+        g_blitters[Indexed][Index][0][1][1] = a_blit__##Blend##_data_##Src##_keyed_doclip; \
+        g_blitters[Indexed][Index][1][0][0] = a_blit__##Blend##_flat_##Src##_block_noclip; \
+        g_blitters[Indexed][Index][1][0][1] = a_blit__##Blend##_flat_##Src##_block_doclip; \
+        g_blitters[Indexed][Index][1][1][0] = a_blit__##Blend##_flat_##Src##_keyed_noclip; \
+        g_blitters[Indexed][Index][1][1][1] = a_blit__##Blend##_flat_##Src##_keyed_doclip; \
+        g_blittersEx[Indexed][Index][0][0] = a_blit__##Blend##_data_##Src##_block_ex;      \
+        g_blittersEx[Indexed][Index][0][1] = a_blit__##Blend##_data_##Src##_keyed_ex;      \
+        g_blittersEx[Indexed][Index][1][0] = a_blit__##Blend##_flat_##Src##_block_ex;      \
+        g_blittersEx[Indexed][Index][1][1] = a_blit__##Blend##_flat_##Src##_keyed_ex;
+
+    #define initRoutines(Index, Blend)                                              \
+        initSource(0, Index, Blend, pixels);                                        \
+        initSource(1, Index, Blend, indices);                                       \
+        g_blitters[0][Index][0][2][0] = a_blit__##Blend##_data_pixels_alpha_noclip; \
+        g_blitters[0][Index][0][2][1] = a_blit__##Blend##_data_pixels_alpha_doclip; \
+        g_blitters[0][Index][1][2][0] = a_blit__##Blend##_flat_pixels_alpha_noclip; \
+        g_blitters[0][Index][1][2][1] = a_blit__##Blend##_flat_pixels_alpha_doclip; \
+        g_blittersEx[0][Index][0][2] = a_blit__##Blend##_data_pixels_alpha_ex;      \
+        g_blittersEx[0][Index][1][2] = a_blit__##Blend##_flat_pixels_alpha_ex;
 
     initRoutines(A_PIXEL_BLEND_PLAIN, plain);
     initRoutines(A_PIXEL_BLEND_RGBA, rgba);
@@ -205,36 +349,123 @@ void a_platform_software_blit__init(void)
     initRoutines(A_PIXEL_BLEND_ADD, add);
 }
 
-static size_t spanBytesNeeded(const APixel* Pixels, int Width, int Height)
+static inline void spanAdd(uint16_t* Spans, size_t* NumSpans, unsigned Value)
+{
+    if(Spans) {
+        Spans[*NumSpans] = (uint16_t)Value;
+    }
+
+    (*NumSpans)++;
+}
+
+static inline bool pixelKeyed(const ASprite* Sprite, int Offset)
+{
+    if(Sprite->indices) {
+        return Sprite->indices[Offset] == 0;
+    }
+
+    return Sprite->pixels[Offset] == a_sprite__colorKey;
+}
+
+static size_t keyedSpansMake(const ASprite* Sprite, int Y, int Y2, uint32_t* Lines, uint16_t* Spans)
 {
-    // Spans format for each graphic line:
-    // [NumSpans << 1 | 1 (draw) / 0 (transparent)][[len]...]
+    // Keyed spans format for each graphic line:
+    // [[Skip, Len]...] for each opaque run, Skip is the number of transparent
+    // pixels since the end of the previous run
+    // Pass NULL Lines and Spans to only count the spans needed
+
+    const int width = Sprite->w;
+    int offset = Y * width;
+    size_t numSpans = 0;
+
+    for(int y = Y; y < Y2; y++, offset += width) {
+        if(Lines) {
+            Lines[y] = (uint32_t)numSpans;
+        }
 
-    size_t bytesNeeded = 0;
+        for(int x = 0; x < width; ) {
+            unsigned skip = 0;
+            unsigned len = 0;
 
-    for(int y = Height; y--; ) {
-        bytesNeeded += sizeof(unsigned); // total size and initial state
-        bool lastState = *Pixels != a_sprite__colorKey; // initial state
+            for( ; x < width && pixelKeyed(Sprite, offset + x); x++) {
+                skip++;
+            }
 
-        for(int x = Width; x--; ) {
-            bool newState = *Pixels++ != a_sprite__colorKey;
+            if(x == width) {
+                break;
+            }
 
-            if(newState != lastState) {
-                bytesNeeded += sizeof(unsigned); // length of new span
-                lastState = newState;
+            for( ; x < width && !pixelKeyed(Sprite, offset + x); x++) {
+                len++;
             }
+
+            // Split what does not fit in 16 bits into empty or adjacent runs
+            for( ; skip > UINT16_MAX; skip -= UINT16_MAX) {
+                spanAdd(Spans, &numSpans, UINT16_MAX);
+                spanAdd(Spans, &numSpans, 0);
+            }
+
+            for( ; len > UINT16_MAX; len -= UINT16_MAX, skip = 0) {
+                spanAdd(Spans, &numSpans, skip);
+                spanAdd(Spans, &numSpans, UINT16_MAX);
+            }
+
+            spanAdd(Spans, &numSpans, skip);
+            spanAdd(Spans, &numSpans, len);
+        }
+    }
+
+    return numSpans;
+}
+
+static size_t alphaSpansMake(const ASprite* Sprite, int Y, int Y2, uint32_t* Lines, uint16_t* Spans)
+{
+    // Alpha spans format for each graphic line:
+    // [[Len << 2 | ABlitAlpha]...]
+    // Pass NULL Lines and Spans to only count the spans needed
+
+    const APixel* pixels = Sprite->pixels + Y * Sprite->w;
+    const uint8_t* alpha = Sprite->alpha + Y * Sprite->w;
+    size_t numSpans = 0;
+
+    for(int y = Y; y < Y2; y++) {
+        if(Lines) {
+            Lines[y] = (uint32_t)numSpans;
         }
 
-        bytesNeeded += sizeof(unsigned); // line's last span length
+        for(int x = Sprite->w; x > 0; ) {
+            ABlitAlpha state = alphaState(*pixels, *alpha);
+            unsigned len = 0;
+
+            do {
+                pixels++;
+                alpha++;
+                len++;
+            } while(--x > 0
+                        && len < UINT16_MAX >> 2
+                        && alphaState(*pixels, *alpha) == state);
+
+            spanAdd(Spans, &numSpans, len << 2 | state);
+        }
     }
 
-    return bytesNeeded;
+    return numSpans;
 }
 
-static bool hasTransparency(const APixel* Pixels, int Width, int Height)
+// Line offsets are relative to Spans, from Lines[Y] to Lines[Y2 - 1]
+static size_t spansMake(const ASprite* Sprite, ABlitMode Mode, int Y, int Y2, uint32_t* Lines, uint16_t* Spans)
 {
-    for(int i = Width * Height; i--; ) {
-        if(*Pixels++ == a_sprite__colorKey) {
+    if(Mode == A_BLIT__ALPHA) {
+        return alphaSpansMake(Sprite, Y, Y2, Lines, Spans);
+    } else {
+        return keyedSpansMake(Sprite, Y, Y2, Lines, Spans);
+    }
+}
+
+static bool hasTransparency(const ASprite* Sprite, int Y, int Y2)
+{
+    for(int i = Y * Sprite->w; i < Y2 * Sprite->w; i++) {
+        if(pixelKeyed(Sprite, i)) {
             return true;
         }
     }
@@ -242,6 +473,16 @@ static bool hasTransparency(const APixel* Pixels, int Width, int Height)
     return false;
 }
 
+// Pixels drawn over clear areas of an alpha sprite become opaque
+static void alphaFill(const ASprite* Sprite, int Y, int Y2)
+{
+    for(int i = Y * Sprite->w; i < Y2 * Sprite->w; i++) {
+        if(Sprite->alpha[i] == 0 && !pixelKeyed(Sprite, i)) {
+            Sprite->alpha[i] = 255;
+        }
+    }
+}
+
 APlatformTexture* a_platform__textureNewScreen(int Width, int Height)
 {
     A_UNUSED(Width);
@@ -250,56 +491,115 @@ APlatformTexture* a_platform__textureNewScreen(int Width, int Height)
     return NULL;
 }
 
-APlatformTexture* a_platform__textureNewSprite(const ASprite* Sprite)
+static size_t bufferSizeGet(const APlatformTexture* Texture, size_t NumSpans)
 {
-    APlatformTexture* texture = Sprite->texture;
-    const APixel* pixels = Sprite->pixels;
-    int width = Sprite->w;
-    int height = Sprite->h;
+    return (size_t)(Texture->spr->h + 1) * sizeof(uint32_t)
+            + NumSpans * sizeof(uint16_t);
+}
 
-    bool colorKeyed = hasTransparency(pixels, width, height);
-    size_t bytesNeeded = colorKeyed
-                            ? spanBytesNeeded(pixels, width, height) : 0;
+static void textureSpansMake(APlatformTexture* Texture)
+{
+    const ASprite* sprite = Texture->spr;
+
+    Texture->dirtyY = 0;
+    Texture->dirtyY2 = 0;
+
+    if(sprite->alpha) {
+        alphaFill(sprite, 0, sprite->h);
+        Texture->mode = A_BLIT__ALPHA;
+    } else if(hasTransparency(sprite, 0, sprite->h)) {
+        Texture->mode = A_BLIT__KEYED;
+    } else {
+        Texture->mode = A_BLIT__BLOCK;
+        return;
+    }
 
-    if(texture == NULL || bytesNeeded > texture->spansSize) {
-        a_platform__textureFree(texture);
-        texture = a_mem_malloc(sizeof(APlatformTexture) + bytesNeeded);
+    const int h = sprite->h;
+    size_t numSpans = spansMake(sprite, Texture->mode, 0, h, NULL, NULL);
+    size_t bytesNeeded = bufferSizeGet(Texture, numSpans);
 
-        texture->spr = Sprite;
-        texture->spansSize = bytesNeeded;
+    if(bytesNeeded > Texture->bufferSize) {
+        a_mem_free(Texture->lines);
+
+        Texture->lines = a_mem_malloc(bytesNeeded);
+        Texture->spans = (uint16_t*)(Texture->lines + h + 1);
+        Texture->bufferSize = bytesNeeded;
     }
 
-    texture->colorKeyed = colorKeyed;
+    spansMake(sprite, Texture->mode, 0, h, Texture->lines, Texture->spans);
+    Texture->lines[h] = (uint32_t)numSpans;
+}
 
-    if(texture->spansSize > 0) {
-        unsigned* spans = texture->spans;
+// Remake the spans of the lines drawn on, in place if they still fit
+static void textureSpansUpdate(APlatformTexture* Texture)
+{
+    #if A__TILES
+        a_platform_software_tiles__flush();
+    #endif
 
-        for(int y = height; y--; ) {
-            unsigned* lineStart = spans;
-            unsigned numSpans = 1; // line has at least 1 span
-            unsigned spanLength = 0;
+    const ASprite* sprite = Texture->spr;
+    const int y = Texture->dirtyY;
+    const int y2 = Texture->dirtyY2;
 
-            bool lastState = *pixels != a_sprite__colorKey; // initial state
-            *spans++ = lastState;
+    Texture->dirtyY = 0;
+    Texture->dirtyY2 = 0;
 
-            for(int x = width; x--; ) {
-                bool newState = *pixels++ != a_sprite__colorKey;
+    if(Texture->mode == A_BLIT__BLOCK) {
+        if(hasTransparency(sprite, y, y2)) {
+            textureSpansMake(Texture);
+        }
 
-                if(newState == lastState) {
-                    spanLength++; // keep growing current span
-                } else {
-                    *spans++ = spanLength; // record the just-ended span length
-                    numSpans++;
-                    spanLength = 1; // start a new span from this pixel
-                    lastState = newState;
-                }
-            }
+        return;
+    }
 
-            *spans++ = spanLength; // record the last span's length
-            *lineStart |= numSpans << 1; // record line's number of spans
-        }
+    if(Texture->mode == A_BLIT__ALPHA) {
+        alphaFill(sprite, y, y2);
     }
 
+    uint32_t* lines = Texture->lines;
+    const size_t oldStart = lines[y];
+    const size_t oldEnd = lines[y2];
+    const size_t oldTotal = lines[sprite->h];
+    const size_t newEnd =
+        oldStart + spansMake(sprite, Texture->mode, y, y2, NULL, NULL);
+
+    if(bufferSizeGet(Texture, oldTotal - oldEnd + newEnd)
+        > Texture->bufferSize) {
+
+        textureSpansMake(Texture);
+        return;
+    }
+
+    memmove(Texture->spans + newEnd,
+            Texture->spans + oldEnd,
+            (oldTotal - oldEnd) * sizeof(uint16_t));
+
+    spansMake(sprite, Texture->mode, y, y2, lines, Texture->spans + oldStart);
+
+    for(int i = y; i < y2; i++) {
+        lines[i] += (uint32_t)oldStart;
+    }
+
+    for(int i = y2; i <= sprite->h; i++) {
+        lines[i] = (uint32_t)(lines[i] - oldEnd + newEnd);
+    }
+}
+
+APlatformTexture* a_platform__textureNewSprite(const ASprite* Sprite)
+{
+    #if A__TILES
+        a_platform_software_tiles__flush();
+    #endif
+
+    APlatformTexture* texture = Sprite->texture;
+
+    if(texture == NULL) {
+        texture = a_mem_zalloc(sizeof(APlatformTexture));
+        texture->spr = Sprite;
+    }
+
+    textureSpansMake(texture);
+
     return texture;
 }
 
@@ -309,33 +609,172 @@ void a_platform__textureFree(APlatformTexture* Texture)
         return;
     }
 
-    free(Texture);
+    #if A__TILES
+        a_platform_software_tiles__flush();
+    #endif
+
+    a_mem_free(Texture->lines);
+    a_mem_free(Texture);
+}
+
+void a_platform_software_blit__textureDirty(APlatformTexture* Texture, int Y, int Y2)
+{
+    if(Y >= Y2) {
+        return;
+    }
+
+    if(Texture->dirtyY < Texture->dirtyY2) {
+        Texture->dirtyY = a_math_min(Texture->dirtyY, Y);
+        Texture->dirtyY2 = a_math_max(Texture->dirtyY2, Y2);
+    } else {
+        Texture->dirtyY = Y;
+        Texture->dirtyY2 = Y2;
+    }
+}
+
+static inline void textureSpansCheck(const APlatformTexture* Texture)
+{
+    if(Texture->dirtyY < Texture->dirtyY2) {
+        // Spans are only a cache of the sprite pixels
+        textureSpansUpdate((APlatformTexture*)Texture);
+    }
 }
 
 void a_platform__textureBlit(const APlatformTexture* Texture, int X, int Y, bool FillFlat)
 {
-    A_UNUSED(FillFlat);
+    textureSpansCheck(Texture);
+
+    #if A__TILES
+        if(a_platform_software_tiles__recording) {
+            ATilesCmd* cmd = a_platform_software_tiles__cmdNew(
+                                A_TILES__CMD_BLIT, Y, Y + Texture->spr->h);
+
+            if(cmd) {
+                cmd->texture = Texture;
+                cmd->args[0] = X;
+                cmd->args[1] = Y;
+                cmd->fillFlat = FillFlat;
+            }
+
+            return;
+        }
+    #endif
 
     if(!a_screen_boxOnClip(X, Y, Texture->spr->w , Texture->spr->h)) {
         return;
     }
 
     g_blitters
+        [Texture->spr->indices != NULL]
         [a_pixel__state.blend]
-        [a_pixel__state.fillBlit]
-        [Texture->colorKeyed]
+        [FillFlat]
+        [Texture->mode]
         [!a_screen_boxInsideClip(X, Y, Texture->spr->w, Texture->spr->h)]
             (Texture, X, Y);
 }
 
 void a_platform__textureBlitEx(const APlatformTexture* Texture, int X, int Y, AFix Scale, unsigned Angle, int CenterX, int CenterY, bool FillFlat)
 {
-    A_UNUSED(Scale);
-    A_UNUSED(Angle);
+    textureSpansCheck(Texture);
+
+    const int w = Texture->spr->w;
+    const int h = Texture->spr->h;
+
+    // Sprite point that lands on X, Y
+    const int pivotX = w / 2 + CenterX;
+    const int pivotY = h / 2 + CenterY;
+
+    if(Angle == 0 && Scale == A_FIX_ONE) {
+        a_platform__textureBlit(Texture, X - pivotX, Y - pivotY, FillFlat);
+        return;
+    }
 
-    a_platform__textureBlit(Texture,
-                            X - Texture->spr->w / 2 - CenterX,
-                            Y - Texture->spr->h / 2 - CenterY,
-                            FillFlat);
+    if(Scale <= 0) {
+        return;
+    }
+
+    #if A__TILES
+        if(a_platform_software_tiles__recording) {
+            int r = a_sprite__blitExRadius(
+                        Texture->spr, Scale, CenterX, CenterY);
+            ATilesCmd* cmd = a_platform_software_tiles__cmdNew(
+                                A_TILES__CMD_BLITEX, Y - r, Y + r);
+
+            if(cmd) {
+                cmd->texture = Texture;
+                cmd->args[0] = X;
+                cmd->args[1] = Y;
+                cmd->args[2] = CenterX;
+                cmd->args[3] = CenterY;
+                cmd->scale = Scale;
+                cmd->angle = Angle;
+                cmd->fillFlat = FillFlat;
+            }
+
+            return;
+        }
+    #endif
+
+    const AFix sin = a_fix_sin(Angle);
+    const AFix cos = a_fix_cos(Angle);
+
+    // Screen bounding box of the rotated and scaled sprite
+    const AFix sinScaled = a_fix_mul(sin, Scale);
+    const AFix cosScaled = a_fix_mul(cos, Scale);
+    const int cornersX[4] = {-pivotX, w - pivotX, -pivotX, w - pivotX};
+    const int cornersY[4] = {-pivotY, -pivotY, h - pivotY, h - pivotY};
+    int64_t minX = INT64_MAX, maxX = INT64_MIN;
+    int64_t minY = INT64_MAX, maxY = INT64_MIN;
+
+    for(int c = 0; c < 4; c++) {
+        int64_t x = (int64_t)cornersX[c] * cosScaled
+                        + (int64_t)cornersY[c] * sinScaled;
+        int64_t y = (int64_t)cornersY[c] * cosScaled
+                        - (int64_t)cornersX[c] * sinScaled;
+
+        minX = x < minX ? x : minX;
+        maxX = x > maxX ? x : maxX;
+        minY = y < minY ? y : minY;
+        maxY = y > maxY ? y : maxY;
+    }
+
+    minX = X + (minX >> A_FIX_BIT_PRECISION);
+    minY = Y + (minY >> A_FIX_BIT_PRECISION);
+    maxX = X + (maxX >> A_FIX_BIT_PRECISION) + 2;
+    maxY = Y + (maxY >> A_FIX_BIT_PRECISION) + 2;
+
+    if(minX >= a__screen.clipX2 || maxX <= a__screen.clipX
+        || minY >= a__screen.clipY2 || maxY <= a__screen.clipY) {
+
+        return;
+    }
+
+    ABlitEx ex;
+
+    ex.x = minX > a__screen.clipX ? (int)minX : a__screen.clipX;
+    ex.y = minY > a__screen.clipY ? (int)minY : a__screen.clipY;
+    ex.x2 = maxX < a__screen.clipX2 ? (int)maxX : a__screen.clipX2;
+    ex.y2 = maxY < a__screen.clipY2 ? (int)maxY : a__screen.clipY2;
+
+    // Inverse mapping, screen offset to sprite offset
+    ex.uDx = a_fix_div(cos, Scale);
+    ex.vDx = a_fix_div(sin, Scale);
+    ex.uDy = -ex.vDx;
+    ex.vDy = ex.uDx;
+
+    const AFix dx = a_fix_fromInt(ex.x - X) + A_FIX_ONE / 2;
+    const AFix dy = a_fix_fromInt(ex.y - Y) + A_FIX_ONE / 2;
+
+    ex.u = a_fix_fromInt(pivotX)
+            + a_fix_mul(dx, ex.uDx) + a_fix_mul(dy, ex.uDy);
+    ex.v = a_fix_fromInt(pivotY)
+            + a_fix_mul(dx, ex.vDx) + a_fix_mul(dy, ex.vDy);
+
+    g_blittersEx
+        [Texture->spr->indices != NULL]
+        [a_pixel__state.blend]
+        [FillFlat]
+        [Texture->mode]
+            (Texture, &ex);
 }
 #endif // A_CONFIG_LIB_RENDER_SOFTWARE
@@ -1,5 +1,5 @@
 /*
-    Copyright 2010, 2016-2018 Alex Margarit <alex@alxm.org>
+    Copyright 2010, 2016-2019 Alex Margarit <alex@alxm.org>
     This file is part of a2x, a C video game framework.
 
     This program is free software: you can redistribute it and/or modify
@@ -16,38 +16,57 @@
     along with this program.  If not, see <http://www.gnu.org/licenses/>.
 */
 
-// Spans format for each graphic line:
-// [NumSpans << 1 | 1 (draw) / 0 (transparent)][[len]...]
+// Plain blends always have a span routine, others only with A__PIXEL_SPANS.
+// Data spans read APixel rows, so indexed sources go pixel by pixel instead.
+#if defined(A__SPAN_NATIVE) || A__PIXEL_SPANS
+    #if defined(A__SPAN_FLAT)
+        #define A__SPAN(Dst, Src, Len) A__SPAN_FLAT(Dst, Len)
+    #elif defined(A__SPAN_DATA) && !A__SRC_INDEXED
+        #define A__SPAN(Dst, Src, Len) A__SPAN_DATA(Dst, Src, Len)
+    #endif
+#endif
+
+#ifdef A__SPAN
+    #define A__SPAN_RUNS 1
+#else
+    #define A__SPAN_RUNS 0
+#endif
+
 static void A__FUNC_NAME(keyed, noclip)(const APlatformTexture* Texture, int X, int Y)
 {
     A__BLEND_SETUP;
+    A__SRC_SETUP;
 
     const int screenW = a__screen.width;
+    const int spriteW = Texture->spr->w;
     APixel* startDst = a__screen.pixels + Y * screenW + X;
-    const APixel* src = Texture->spr->pixels;
-    const unsigned* spans = Texture->spans;
+    const A__SRC_TYPE* startSrc = Texture->spr->A__SRC;
+    const uint16_t* spans = Texture->spans;
+    const uint32_t* lines = Texture->lines;
 
-    for(int i = Texture->spr->h; i--; startDst += screenW) {
-        bool draw = *spans & 1;
-        unsigned numSpans = *spans++ >> 1;
+    for(int i = Texture->spr->h; i--; startDst += screenW, startSrc += spriteW) {
+        const uint16_t* lineEnd = Texture->spans + *++lines;
         APixel* dst = startDst;
+        const A__SRC_TYPE* src = startSrc;
 
-        while(numSpans--) {
-            int len = (int)*spans++;
+        for( ; spans < lineEnd; spans += 2) {
+            int len = spans[1];
 
-            if(draw) {
+            dst += spans[0];
+            src += spans[0];
+
+            #if A__SPAN_RUNS
+                A__SPAN(dst, src, len);
+                dst += len;
+                src += len;
+            #else
                 while(len--) {
                     A__PIXEL_SETUP;
                     A__PIXEL_DRAW(dst);
                     dst++;
                     src++;
                 }
-            } else {
-                dst += len;
-                src += len;
-            }
-
-            draw = !draw;
+            #endif
         }
     }
 }
@@ -55,6 +74,7 @@ static void A__FUNC_NAME(keyed, noclip)(const APlatformTexture* Texture, int X,
 static void A__FUNC_NAME(keyed, doclip)(const APlatformTexture* Texture, int X, int Y)
 {
     A__BLEND_SETUP;
+    A__SRC_SETUP;
 
     const int screenW = a__screen.width;
     const int spriteW = Texture->spr->w;
@@ -66,101 +86,87 @@ static void A__FUNC_NAME(keyed, doclip)(const APlatformTexture* Texture, int X,
     const int xClipRight = a_math_max(0, X + spriteW - a__screen.clipX2);
 
     const int rows = spriteH - yClipUp - yClipDown;
-    const int columns = spriteW - xClipLeft - xClipRight;
+    const int xEnd = spriteW - xClipRight;
 
-    APixel* startDst = a__screen.pixels
-                        + (Y + yClipUp) * screenW + X + xClipLeft;
-    const APixel* startSrc = Texture->spr->pixels
-                                + yClipUp * spriteW + xClipLeft;
-    const unsigned* spans = Texture->spans;
+    APixel* startDst = a__screen.pixels + (Y + yClipUp) * screenW + X;
+    const A__SRC_TYPE* startSrc = Texture->spr->A__SRC + yClipUp * spriteW;
 
-    // skip clipped top rows
-    for(int i = yClipUp; i--; ) {
-        spans += 1 + (*spans >> 1);
-    }
+    // Jump over clipped top rows
+    const uint32_t* lines = Texture->lines + yClipUp;
+    const uint16_t* spans = Texture->spans + *lines;
 
-    // draw visible rows
     for(int i = rows; i--; startDst += screenW, startSrc += spriteW) {
-        bool draw = *spans & 1;
-        const unsigned* nextLine = spans + 1 + (*spans >> 1);
-        APixel* dst = startDst;
-        const APixel* src = startSrc;
-        int clippedLen = 0;
-        int drawColumns = columns;
-
-        // skip clipped left columns
-        while(clippedLen < xClipLeft) {
-            clippedLen += (int)*++spans;
-            draw = !draw;
-        }
+        const uint16_t* lineEnd = Texture->spans + *++lines;
+        int x = 0;
 
-        // account for overclipping
-        if(clippedLen > xClipLeft) {
-            int len = clippedLen - xClipLeft;
+        for( ; spans < lineEnd; spans += 2) {
+            x += spans[0];
 
-            // Inverse logic because we're drawing from the previous span
-            if(draw) {
-                dst += len;
-                src += len;
-                drawColumns -= len;
-            } else {
-                while(len-- && drawColumns--) {
-                    A__PIXEL_SETUP;
-                    A__PIXEL_DRAW(dst);
-                    dst++;
-                    src++;
-                }
+            if(x >= xEnd) {
+                break;
             }
-        }
 
-        // draw visible columns
-        while(drawColumns > 0) {
-            int len = (int)*++spans;
+            const int start = a_math_max(x, xClipLeft);
+
+            x += spans[1];
+
+            int len = a_math_min(x, xEnd) - start;
 
-            if(draw) {
-                while(len-- && drawColumns--) {
+            if(len <= 0) {
+                continue;
+            }
+
+            APixel* dst = startDst + start;
+            const A__SRC_TYPE* src = startSrc + start;
+
+            #if A__SPAN_RUNS
+                A__SPAN(dst, src, len);
+            #else
+                while(len--) {
                     A__PIXEL_SETUP;
                     A__PIXEL_DRAW(dst);
                     dst++;
                     src++;
                 }
-            } else {
-                dst += len;
-                src += len;
-                drawColumns -= len;
-            }
+            #endif
 
-            draw = !draw;
+            A_UNUSED(src);
         }
 
-        // skip clipped right columns
-        spans = nextLine;
+        spans = lineEnd;
     }
 }
 
 static void A__FUNC_NAME(block, noclip)(const APlatformTexture* Texture, int X, int Y)
 {
     A__BLEND_SETUP;
+    A__SRC_SETUP;
 
     const int screenW = a__screen.width;
     APixel* startDst = a__screen.pixels + Y * screenW + X;
-    const APixel* src = Texture->spr->pixels;
+    const A__SRC_TYPE* src = Texture->spr->A__SRC;
 
     for(int i = Texture->spr->h; i--; startDst += screenW) {
         APixel* dst = startDst;
 
-        for(int j = Texture->spr->w; j--; ) {
-            A__PIXEL_SETUP;
-            A__PIXEL_DRAW(dst);
-            dst++;
-            src++;
-        }
+        #if A__SPAN_RUNS
+            A__SPAN(dst, src, Texture->spr->w);
+            src += Texture->spr->w;
+        #else
+            for(int j = Texture->spr->w; j--; ) {
+                A__PIXEL_SETUP;
+                A__PIXEL_DRAW(dst);
+                dst++;
+                src++;
+            }
+        #endif
     }
 }
 
 static void A__FUNC_NAME(block, doclip)(const APlatformTexture* Texture, int X, int Y)
 {
     A__BLEND_SETUP;
+    A__SRC_SETUP;
 
     const int screenW = a__screen.width;
     const int spriteW = Texture->spr->w;
@@ -176,24 +182,255 @@ static void A__FUNC_NAME(block, doclip)(const APlatformTexture* Texture, int X,
 
     APixel* startDst = a__screen.pixels
                         + (Y + yClipUp) * screenW + X + xClipLeft;
-    const APixel* startSrc = Texture->spr->pixels
+    const A__SRC_TYPE* startSrc = Texture->spr->A__SRC
                                 + yClipUp * spriteW + xClipLeft;
 
     for(int i = rows; i--; startDst += screenW, startSrc += spriteW) {
         APixel* dst = startDst;
-        const APixel* src = startSrc;
 
-        for(int j = columns; j--; ) {
-            A__PIXEL_SETUP;
-            A__PIXEL_DRAW(dst);
-            dst++;
-            src++;
+        #if A__SPAN_RUNS
+            A__SPAN(dst, startSrc, columns);
+        #else
+            const A__SRC_TYPE* src = startSrc;
+
+            for(int j = columns; j--; ) {
+                A__PIXEL_SETUP;
+                A__PIXEL_DRAW(dst);
+                dst++;
+                src++;
+            }
+        #endif
+    }
+}
+
+static void A__FUNC_NAME(keyed, ex)(const APlatformTexture* Texture, const ABlitEx* Ex)
+{
+    A__BLEND_SETUP;
+    A__SRC_SETUP;
+
+    const int screenW = a__screen.width;
+    const int spriteW = Texture->spr->w;
+    const int spriteH = Texture->spr->h;
+    const A__SRC_TYPE* pixels = Texture->spr->A__SRC;
+    APixel* startDst = a__screen.pixels + Ex->y * screenW + Ex->x;
+    AFix rowU = Ex->u;
+    AFix rowV = Ex->v;
+
+    for(int i = Ex->y2 - Ex->y; i--; ) {
+        int start, end;
+
+        if(exSpan(Ex, spriteW, spriteH, rowU, rowV, &start, &end)) {
+            APixel* dst = startDst + start;
+            AFix u = rowU + start * Ex->uDx;
+            AFix v = rowV + start * Ex->vDx;
+
+            for(int j = end - start; j--; ) {
+                const A__SRC_TYPE* src = pixels
+                                    + a_fix_toInt(v) * spriteW
+                                    + a_fix_toInt(u);
+
+                if(!A__SRC_KEY(src)) {
+                    A__PIXEL_SETUP;
+                    A__PIXEL_DRAW(dst);
+                }
+
+                dst++;
+                u += Ex->uDx;
+                v += Ex->vDx;
+            }
         }
+
+        startDst += screenW;
+        rowU += Ex->uDy;
+        rowV += Ex->vDy;
     }
 }
 
-#undef A__BLEND
-#undef A__FILL
-#undef A__BLEND_SETUP
-#undef A__PIXEL_SETUP
-#undef A__PIXEL_PARAMS
+static void A__FUNC_NAME(block, ex)(const APlatformTexture* Texture, const ABlitEx* Ex)
+{
+    A__BLEND_SETUP;
+    A__SRC_SETUP;
+
+    const int screenW = a__screen.width;
+    const int spriteW = Texture->spr->w;
+    const int spriteH = Texture->spr->h;
+    const A__SRC_TYPE* pixels = Texture->spr->A__SRC;
+    APixel* startDst = a__screen.pixels + Ex->y * screenW + Ex->x;
+    AFix rowU = Ex->u;
+    AFix rowV = Ex->v;
+
+    for(int i = Ex->y2 - Ex->y; i--; ) {
+        int start, end;
+
+        if(exSpan(Ex, spriteW, spriteH, rowU, rowV, &start, &end)) {
+            APixel* dst = startDst + start;
+            AFix u = rowU + start * Ex->uDx;
+            AFix v = rowV + start * Ex->vDx;
+
+            for(int j = end - start; j--; ) {
+                const A__SRC_TYPE* src = pixels
+                                    + a_fix_toInt(v) * spriteW
+                                    + a_fix_toInt(u);
+                A_UNUSED(src);
+
+                A__PIXEL_SETUP;
+                A__PIXEL_DRAW(dst);
+
+                dst++;
+                u += Ex->uDx;
+                v += Ex->vDx;
+            }
+        }
+
+        startDst += screenW;
+        rowU += Ex->uDy;
+        rowV += Ex->vDy;
+    }
+}
+
+#if !A__SRC_INDEXED
+static void A__FUNC_NAME(alpha, doclip)(const APlatformTexture* Texture, int X, int Y)
+{
+    A__BLEND_SETUP;
+
+    const int screenW = a__screen.width;
+    const int spriteW = Texture->spr->w;
+    const int spriteH = Texture->spr->h;
+
+    const int yClipUp = a_math_max(0, a__screen.clipY - Y);
+    const int yClipDown = a_math_max(0, Y + spriteH - a__screen.clipY2);
+    const int xClipLeft = a_math_max(0, a__screen.clipX - X);
+    const int xClipRight = a_math_max(0, X + spriteW - a__screen.clipX2);
+
+    const int rows = spriteH - yClipUp - yClipDown;
+    const int xEnd = spriteW - xClipRight;
+
+    APixel* startDst = a__screen.pixels + (Y + yClipUp) * screenW + X;
+    const APixel* startSrc = Texture->spr->pixels + yClipUp * spriteW;
+    const uint8_t* startAlpha = Texture->spr->alpha + yClipUp * spriteW;
+
+    // Jump over clipped top rows
+    const uint32_t* lines = Texture->lines + yClipUp;
+    const uint16_t* spans = Texture->spans + *lines;
+
+    for(int i = rows; i--; ) {
+        const uint16_t* lineEnd = Texture->spans + *++lines;
+        int x = 0;
+
+        for( ; spans < lineEnd && x < xEnd; spans++) {
+            const int start = a_math_max(x, xClipLeft);
+            const int end = a_math_min(x + (*spans >> 2), xEnd);
+            const ABlitAlpha state = (ABlitAlpha)(*spans & 3);
+
+            x += *spans >> 2;
+
+            if(start >= end || state == A_BLIT__ALPHA_CLEAR) {
+                continue;
+            }
+
+            int len = end - start;
+            APixel* dst = startDst + start;
+            const APixel* src = startSrc + start;
+
+            if(state == A_BLIT__ALPHA_OPAQUE) {
+                #if A__SPAN_RUNS
+                    A__SPAN(dst, src, len);
+                #else
+                    while(len--) {
+                        A__PIXEL_SETUP;
+                        A__PIXEL_DRAW(dst);
+                        dst++;
+                        src++;
+                    }
+                #endif
+            } else {
+                const uint8_t* srcAlpha = startAlpha + start;
+
+                while(len--) {
+                    APixel blended = *dst;
+
+                    A__PIXEL_SETUP;
+                    A__PIXEL_DRAW(&blended);
+                    alphaMix(dst, blended, *srcAlpha);
+
+                    dst++;
+                    src++;
+                    srcAlpha++;
+                }
+            }
+
+            A_UNUSED(src);
+        }
+
+        spans = lineEnd;
+        startDst += screenW;
+        startSrc += spriteW;
+        startAlpha += spriteW;
+    }
+}
+
+static void A__FUNC_NAME(alpha, noclip)(const APlatformTexture* Texture, int X, int Y)
+{
+    // Spans are clipped one at a time, so there is no cheaper unclipped form
+    A__FUNC_NAME(alpha, doclip)(Texture, X, Y);
+}
+
+static void A__FUNC_NAME(alpha, ex)(const APlatformTexture* Texture, const ABlitEx* Ex)
+{
+    A__BLEND_SETUP;
+
+    const int screenW = a__screen.width;
+    const int spriteW = Texture->spr->w;
+    const int spriteH = Texture->spr->h;
+    const APixel* pixels = Texture->spr->pixels;
+    const uint8_t* alphas = Texture->spr->alpha;
+    APixel* startDst = a__screen.pixels + Ex->y * screenW + Ex->x;
+    AFix rowU = Ex->u;
+    AFix rowV = Ex->v;
+
+    for(int i = Ex->y2 - Ex->y; i--; ) {
+        int start, end;
+
+        if(exSpan(Ex, spriteW, spriteH, rowU, rowV, &start, &end)) {
+            APixel* dst = startDst + start;
+            AFix u = rowU + start * Ex->uDx;
+            AFix v = rowV + start * Ex->vDx;
+
+            for(int j = end - start; j--; ) {
+                const int offset = a_fix_toInt(v) * spriteW + a_fix_toInt(u);
+                const APixel* src = pixels + offset;
+                const ABlitAlpha state = alphaState(*src, alphas[offset]);
+
+                if(state == A_BLIT__ALPHA_OPAQUE) {
+                    A__PIXEL_SETUP;
+                    A__PIXEL_DRAW(dst);
+                } else if(state == A_BLIT__ALPHA_PARTIAL) {
+                    APixel blended = *dst;
+
+                    A__PIXEL_SETUP;
+                    A__PIXEL_DRAW(&blended);
+                    alphaMix(dst, blended, alphas[offset]);
+                }
+
+                dst++;
+                u += Ex->uDx;
+                v += Ex->vDx;
+            }
+        }
+
+        startDst += screenW;
+        rowU += Ex->uDy;
+        rowV += Ex->vDy;
+    }
+}
+
+#endif // !A__SRC_INDEXED
+
+#undef A__SRC
+#undef A__SRC_INDEXED
+#undef A__SRC_TYPE
+#undef A__SRC_SETUP
+#undef A__SRC_PIXEL
+#undef A__SRC_KEY
+#undef A__SPAN
+#undef A__SPAN_RUNS
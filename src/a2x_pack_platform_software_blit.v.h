@@ -20,4 +20,8 @@
 
 #include "a2x_pack_platform_software_blit.p.h"
 
+#include "a2x_pack_platform.v.h"
+
 extern void a_platform_software_blit__init(void);
+
+extern void a_platform_software_blit__textureDirty(APlatformTexture* Texture, int Y, int Y2);
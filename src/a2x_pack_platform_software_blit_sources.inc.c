@@ -0,0 +1,46 @@
+/*
+    Copyright 2019 Alex Margarit <alex@alxm.org>
+    This file is part of a2x, a C video game framework.
+
+    This program is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    This program is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with this program.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+// Instantiate the current blend's routines for each sprite source format
+
+#define A__SRC pixels
+#define A__SRC_INDEXED 0
+#define A__SRC_TYPE APixel
+#define A__SRC_SETUP
+#define A__SRC_PIXEL (*src)
+#define A__SRC_KEY(Src) (*(Src) == a_sprite__colorKey)
+#include "a2x_pack_platform_software_blit.inc.c"
+
+#define A__SRC indices
+#define A__SRC_INDEXED 1
+#define A__SRC_TYPE uint8_t
+#define A__SRC_SETUP                                    \
+    const APixel* palette = blitPalette(Texture->spr); \
+    A_UNUSED(palette);
+#define A__SRC_PIXEL (palette[*src])
+#define A__SRC_KEY(Src) (*(Src) == 0)
+#include "a2x_pack_platform_software_blit.inc.c"
+
+#undef A__BLEND
+#undef A__FILL
+#undef A__BLEND_SETUP
+#undef A__PIXEL_SETUP
+#undef A__PIXEL_PARAMS
+#undef A__SPAN_DATA
+#undef A__SPAN_FLAT
+#undef A__SPAN_NATIVE
@@ -21,34 +21,48 @@
 #if A_CONFIG_LIB_RENDER_SOFTWARE
 #include "a2x_pack_draw.v.h"
 #include "a2x_pack_pixel.v.h"
+#include "a2x_pack_pixel_simd.v.h"
+#include "a2x_pack_platform_software_tiles.v.h"
 #include "a2x_pack_screen.v.h"
 
 typedef void (*ADrawPixel)(int X, int Y);
+typedef void (*ADrawPixels)(const AVectorInt* Points, unsigned NumPoints);
 typedef void (*ADrawRectangle)(int X, int Y, int Width, int Height);
 typedef void (*ADrawLine)(int X1, int Y1, int X2, int Y2);
 typedef void (*ADrawHLine)(int X1, int X2, int Y);
 typedef void (*ADrawVLine)(int X, int Y1, int Y2);
 typedef void (*ADrawCircle)(int X, int Y, int Radius);
+typedef void (*ADrawEllipse)(int X, int Y, int RadiusX, int RadiusY);
+typedef void (*ADrawTriangle)(int X1, int Y1, int X2, int Y2, int X3, int Y3);
 
-static ADrawPixel g_draw_pixel;
+static A__THREAD_LOCAL ADrawPixel g_draw_pixel;
 static ADrawPixel g_pixel[A_PIXEL_BLEND_NUM];
 
-static ADrawRectangle g_draw_rectangle;
+static A__THREAD_LOCAL ADrawPixels g_draw_pixels;
+static ADrawPixels g_pixels[A_PIXEL_BLEND_NUM];
+
+static A__THREAD_LOCAL ADrawRectangle g_draw_rectangle;
 static ADrawRectangle g_rectangle[A_PIXEL_BLEND_NUM][2]; // [Blend][Fill]
 
-static ADrawLine g_draw_line;
+static A__THREAD_LOCAL ADrawLine g_draw_line;
 static ADrawLine g_line[A_PIXEL_BLEND_NUM];
 
-static ADrawHLine g_draw_hline;
+static A__THREAD_LOCAL ADrawHLine g_draw_hline;
 static ADrawHLine g_hline[A_PIXEL_BLEND_NUM];
 
-static ADrawVLine g_draw_vline;
+static A__THREAD_LOCAL ADrawVLine g_draw_vline;
 static ADrawHLine g_vline[A_PIXEL_BLEND_NUM];
 
-static ADrawCircle g_draw_circle_noclip;
-static ADrawCircle g_draw_circle_clip;
+static A__THREAD_LOCAL ADrawCircle g_draw_circle_noclip;
+static A__THREAD_LOCAL ADrawCircle g_draw_circle_clip;
 static ADrawCircle g_circle[A_PIXEL_BLEND_NUM][2][2]; // [Blend][Clip][Fill]
 
+static A__THREAD_LOCAL ADrawEllipse g_draw_ellipse;
+static ADrawEllipse g_ellipse[A_PIXEL_BLEND_NUM][2]; // [Blend][Fill]
+
+static A__THREAD_LOCAL ADrawTriangle g_draw_triangle;
+static ADrawTriangle g_triangle[A_PIXEL_BLEND_NUM];
+
 static bool cohen_sutherland_clip(int* X1, int* Y1, int* X2, int* Y2)
 {
     int x1 = *X1;
@@ -213,6 +227,88 @@ do {                                                                        \
     }                                                                       \
 } while(0)
 
+#define drawSpan(X1, X2, Y)                                                 \
+    A__PIXEL_SPAN(a__screen.pixels + (Y) * a__screen.width + (X1),          \
+                  (X2) - (X1) + 1)
+
+#define drawSpanClipped(X1, X2, Y)                                          \
+do {                                                                        \
+    const int spanY = Y;                                                    \
+                                                                            \
+    if(spanY < a__screen.clipY || spanY >= a__screen.clipY2) {              \
+        break;                                                              \
+    }                                                                       \
+                                                                            \
+    const int spanX1 = a_math_max(X1, a__screen.clipX);                     \
+    const int spanX2 = a_math_min(X2, a__screen.clipX2 - 1);                \
+                                                                            \
+    if(spanX1 <= spanX2) {                                                  \
+        drawSpan(spanX1, spanX2, spanY);                                    \
+    }                                                                       \
+} while(0)
+
+// Each row is emitted once, so blends that read the screen stay correct
+#define drawCircleFilled(X, Y, Radius, Span)                                \
+do {                                                                        \
+    int x = Radius;                                                         \
+    int y = 0;                                                              \
+    int error = -Radius / 2;                                                \
+                                                                            \
+    int x1 = X - 1 - x;                                                     \
+    int x2 = X + x;                                                         \
+    int y1 = Y - 1 - y;                                                     \
+    int y2 = Y + y;                                                         \
+    int x3 = X - 1 - y;                                                     \
+    int x4 = X + y;                                                         \
+    int y3 = Y - 1 - x;                                                     \
+    int y4 = Y + x;                                                         \
+                                                                            \
+    while(x > y) {                                                          \
+        Span(x1, x2, y1);                                                   \
+        Span(x1, x2, y2);                                                   \
+                                                                            \
+        error += 2 * y + 1; /* (y+1)^2 = y^2 + 2y + 1 */                    \
+        y++;                                                                \
+                                                                            \
+        y1--;                                                               \
+        y2++;                                                               \
+        x3--;                                                               \
+        x4++;                                                               \
+                                                                            \
+        if(error > 0) { /* check if x^2 + y^2 > r^2 */                      \
+            Span(x3, x4, y3);                                               \
+            Span(x3, x4, y4);                                               \
+                                                                            \
+            error += -2 * x + 1; /* (x-1)^2 = x^2 - 2x + 1 */               \
+            x--;                                                            \
+                                                                            \
+            x1++;                                                           \
+            x2--;                                                           \
+            y3++;                                                           \
+            y4--;                                                           \
+        }                                                                   \
+    }                                                                       \
+                                                                            \
+    if(x == y) {                                                            \
+        Span(x3, x4, y3);                                                   \
+        Span(x3, x4, y4);                                                   \
+    }                                                                       \
+} while(0)
+
+#define drawTriangleRows(YStart, YEnd, Left, Right)                         \
+    for(int y = YStart; y < YEnd; y++) {                                    \
+        const int x1 = a_math_max((Left)->x, a__screen.clipX);              \
+        const int x2 = a_math_min((Right)->x, a__screen.clipX2);            \
+        APixel* dst = a__screen.pixels + y * a__screen.width + x1;          \
+                                                                            \
+        if(x2 > x1) {                                                       \
+            A__PIXEL_SPAN(dst, x2 - x1);                                    \
+        }                                                                   \
+                                                                            \
+        a_draw__edgeStep(Left);                                             \
+        a_draw__edgeStep(Right);                                            \
+    }
+
 #define A__FUNC_NAME_EXPAND2(Name, Blend) a_draw__##Name##_##Blend
 #define A__FUNC_NAME_EXPAND(Name, Blend) A__FUNC_NAME_EXPAND2(Name, Blend)
 #define A__FUNC_NAME(Name) A__FUNC_NAME_EXPAND(Name, A__BLEND)
@@ -221,10 +317,26 @@ do {                                                                        \
 #define A__PIXEL_DRAW_EXPAND(Blend, Params) A__PIXEL_DRAW_EXPAND2(Blend)(Params)
 #define A__PIXEL_DRAW(Dst) A__PIXEL_DRAW_EXPAND(A__BLEND, Dst A__PIXEL_PARAMS)
 
+// Horizontal runs of Len > 0 pixels go through the wide fill and span
+// routines where a blend has them, one pixel at a time otherwise
+#define A__PIXEL_SPAN_LOOP(Dst, Len)        \
+    for(int n = Len; n--; ) {               \
+        A__PIXEL_DRAW(Dst + n);             \
+    }
+
+#if A__PIXEL_SPANS
+    #define A__PIXEL_SPAN_FLAT(Blend, Dst, Len, Alpha) \
+        a_pixel__span_##Blend##_flat(Dst, Len, red, green, blue, Alpha)
+#else
+    #define A__PIXEL_SPAN_FLAT(Blend, Dst, Len, Alpha) \
+        A__PIXEL_SPAN_LOOP(Dst, Len)
+#endif
+
 #define A__BLEND plain
 #define A__BLEND_SETUP \
     const APixel color = a_pixel__state.pixel;
 #define A__PIXEL_PARAMS , color
+#define A__PIXEL_SPAN(Dst, Len) a_pixel__fill(Dst, Len, color)
 #include "a2x_pack_platform_software_draw.inc.c"
 
 #define A__BLEND rgba
@@ -237,6 +349,7 @@ do {                                                                        \
         return;                             \
     }
 #define A__PIXEL_PARAMS , red, green, blue, alpha
+#define A__PIXEL_SPAN(Dst, Len) A__PIXEL_SPAN_FLAT(rgba, Dst, Len, alpha)
 #include "a2x_pack_platform_software_draw.inc.c"
 
 #define A__BLEND rgb25
@@ -245,6 +358,7 @@ do {                                                                        \
     const int green = a_pixel__state.green; \
     const int blue = a_pixel__state.blue;
 #define A__PIXEL_PARAMS , red, green, blue
+#define A__PIXEL_SPAN(Dst, Len) A__PIXEL_SPAN_FLAT(rgb25, Dst, Len, 0)
 #include "a2x_pack_platform_software_draw.inc.c"
 
 #define A__BLEND rgb50
@@ -253,6 +367,7 @@ do {                                                                        \
     const int green = a_pixel__state.green; \
     const int blue = a_pixel__state.blue;
 #define A__PIXEL_PARAMS , red, green, blue
+#define A__PIXEL_SPAN(Dst, Len) A__PIXEL_SPAN_FLAT(rgb50, Dst, Len, 0)
 #include "a2x_pack_platform_software_draw.inc.c"
 
 #define A__BLEND rgb75
@@ -261,11 +376,13 @@ do {                                                                        \
     const int green = a_pixel__state.green; \
     const int blue = a_pixel__state.blue;
 #define A__PIXEL_PARAMS , red, green, blue
+#define A__PIXEL_SPAN(Dst, Len) A__PIXEL_SPAN_FLAT(rgb75, Dst, Len, 0)
 #include "a2x_pack_platform_software_draw.inc.c"
 
 #define A__BLEND inverse
 #define A__BLEND_SETUP
 #define A__PIXEL_PARAMS
+#define A__PIXEL_SPAN(Dst, Len) A__PIXEL_SPAN_LOOP(Dst, Len)
 #include "a2x_pack_platform_software_draw.inc.c"
 
 #define A__BLEND mod
@@ -274,6 +391,7 @@ do {                                                                        \
     const int green = a_pixel__state.green; \
     const int blue = a_pixel__state.blue;
 #define A__PIXEL_PARAMS , red, green, blue
+#define A__PIXEL_SPAN(Dst, Len) A__PIXEL_SPAN_FLAT(mod, Dst, Len, 0)
 #include "a2x_pack_platform_software_draw.inc.c"
 
 #define A__BLEND add
@@ -282,12 +400,14 @@ do {                                                                        \
     const int green = a_pixel__state.green; \
     const int blue = a_pixel__state.blue;
 #define A__PIXEL_PARAMS , red, green, blue
+#define A__PIXEL_SPAN(Dst, Len) A__PIXEL_SPAN_FLAT(add, Dst, Len, 0)
 #include "a2x_pack_platform_software_draw.inc.c"
 
 void a_platform_software_draw__init(void)
 {
     #define initRoutines(Index, Blend)                                \
         g_pixel[Index] = a_draw__pixel_##Blend;                       \
+        g_pixels[Index] = a_draw__pixels_##Blend;                     \
         g_rectangle[Index][0] = a_draw__rectangle_nofill_##Blend;     \
         g_rectangle[Index][1] = a_draw__rectangle_fill_##Blend;       \
         g_line[Index] = a_draw__line_##Blend;                         \
@@ -296,7 +416,10 @@ void a_platform_software_draw__init(void)
         g_circle[Index][0][0] = a_draw__circle_noclip_nofill_##Blend; \
         g_circle[Index][0][1] = a_draw__circle_noclip_fill_##Blend;   \
         g_circle[Index][1][0] = a_draw__circle_clip_nofill_##Blend;   \
-        g_circle[Index][1][1] = a_draw__circle_clip_fill_##Blend;
+        g_circle[Index][1][1] = a_draw__circle_clip_fill_##Blend;     \
+        g_ellipse[Index][0] = a_draw__ellipse_nofill_##Blend;         \
+        g_ellipse[Index][1] = a_draw__ellipse_fill_##Blend;           \
+        g_triangle[Index] = a_draw__triangle_##Blend;
 
     initRoutines(A_PIXEL_BLEND_PLAIN, plain);
     initRoutines(A_PIXEL_BLEND_RGBA, rgba);
@@ -316,22 +439,51 @@ void a_platform_software_draw__updateRoutines(void)
     bool fill = a_pixel__state.fillDraw;
 
     g_draw_pixel = g_pixel[blend];
+    g_draw_pixels = g_pixels[blend];
     g_draw_rectangle = g_rectangle[blend][fill];
     g_draw_line = g_line[blend];
     g_draw_hline = g_hline[blend];
     g_draw_vline = g_vline[blend];
     g_draw_circle_noclip = g_circle[blend][0][fill];
     g_draw_circle_clip = g_circle[blend][1][fill];
+    g_draw_ellipse = g_ellipse[blend][fill];
+    g_draw_triangle = g_triangle[blend];
 }
 
+#if A__TILES
+static bool record(ATilesCmdType Type, int Y, int Y2, int A0, int A1, int A2, int A3)
+{
+    if(!a_platform_software_tiles__recording) {
+        return false;
+    }
+
+    ATilesCmd* cmd = a_platform_software_tiles__cmdNew(Type, Y, Y2);
+
+    if(cmd) {
+        cmd->args[0] = A0;
+        cmd->args[1] = A1;
+        cmd->args[2] = A2;
+        cmd->args[3] = A3;
+    }
+
+    return true;
+}
+#endif
+
 void a_platform__drawPixel(int X, int Y)
 {
+    #if A__TILES
+        if(record(A_TILES__CMD_PIXEL, Y, Y + 1, X, Y, 0, 0)) {
+            return;
+        }
+    #endif
+
     if(a_screen_boxInsideClip(X, Y, 1, 1)) {
         g_draw_pixel(X, Y);
     }
 }
 
-void a_platform__drawLine(int X1, int Y1, int X2, int Y2)
+static void drawLine(int X1, int Y1, int X2, int Y2)
 {
     int x = a_math_min(X1, X2);
     int y = a_math_min(Y1, Y2);
@@ -347,8 +499,61 @@ void a_platform__drawLine(int X1, int Y1, int X2, int Y2)
     g_draw_line(X1, Y1, X2, Y2);
 }
 
+void a_platform__drawPixels(const AVectorInt* Points, unsigned NumPoints)
+{
+    #if A__TILES
+        if(a_platform_software_tiles__recording) {
+            for(unsigned p = 0; p < NumPoints; p++) {
+                a_platform__drawPixel(Points[p].x, Points[p].y);
+            }
+
+            return;
+        }
+    #endif
+
+    g_draw_pixels(Points, NumPoints);
+}
+
+void a_platform__drawLine(int X1, int Y1, int X2, int Y2)
+{
+    #if A__TILES
+        if(record(A_TILES__CMD_LINE,
+                  a_math_min(Y1, Y2),
+                  a_math_max(Y1, Y2) + 1,
+                  X1, Y1, X2, Y2)) {
+            return;
+        }
+    #endif
+
+    drawLine(X1, Y1, X2, Y2);
+}
+
+void a_platform__drawLines(const AVectorInt* Points, unsigned NumLines)
+{
+    #if A__TILES
+        if(a_platform_software_tiles__recording) {
+            for(unsigned l = 0; l < NumLines; l++, Points += 2) {
+                a_platform__drawLine(
+                    Points[0].x, Points[0].y, Points[1].x, Points[1].y);
+            }
+
+            return;
+        }
+    #endif
+
+    for(unsigned l = 0; l < NumLines; l++, Points += 2) {
+        drawLine(Points[0].x, Points[0].y, Points[1].x, Points[1].y);
+    }
+}
+
 void a_platform__drawHLine(int X1, int X2, int Y)
 {
+    #if A__TILES
+        if(record(A_TILES__CMD_HLINE, Y, Y + 1, X1, X2, Y, 0)) {
+            return;
+        }
+    #endif
+
     if(!a_screen_boxOnClip(X1, Y, X2 - X1 + 1, 1)) {
         return;
     }
@@ -361,6 +566,12 @@ void a_platform__drawHLine(int X1, int X2, int Y)
 
 void a_platform__drawVLine(int X, int Y1, int Y2)
 {
+    #if A__TILES
+        if(record(A_TILES__CMD_VLINE, Y1, Y2 + 1, X, Y1, Y2, 0)) {
+            return;
+        }
+    #endif
+
     if(!a_screen_boxOnClip(X, Y1, 1, Y2 - Y1 + 1)) {
         return;
     }
@@ -395,14 +606,78 @@ static void drawRectangle(int X, int Y, int Width, int Height)
 
 void a_platform__drawRectangleFilled(int X, int Y, int Width, int Height)
 {
+    #if A__TILES
+        if(record(A_TILES__CMD_RECTANGLE_FILLED,
+                  Y,
+                  Y + a_math_max(Height, 1),
+                  X, Y, Width, Height)) {
+            return;
+        }
+    #endif
+
     drawRectangle(X, Y, Width, Height);
 }
 
 void a_platform__drawRectangleOutline(int X, int Y, int Width, int Height)
 {
+    #if A__TILES
+        if(record(A_TILES__CMD_RECTANGLE_OUTLINE,
+                  Y,
+                  Y + a_math_max(Height, 1),
+                  X, Y, Width, Height)) {
+            return;
+        }
+    #endif
+
     drawRectangle(X, Y, Width, Height);
 }
 
+void a_platform__drawRectanglesFilled(const AVectorInt* Rectangles, unsigned NumRectangles)
+{
+    #if A__TILES
+        if(a_platform_software_tiles__recording) {
+            for(unsigned r = 0; r < NumRectangles; r++, Rectangles += 2) {
+                a_platform__drawRectangleFilled(Rectangles[0].x,
+                                                Rectangles[0].y,
+                                                Rectangles[1].x,
+                                                Rectangles[1].y);
+            }
+
+            return;
+        }
+    #endif
+
+    for(unsigned r = 0; r < NumRectangles; r++, Rectangles += 2) {
+        drawRectangle(Rectangles[0].x,
+                      Rectangles[0].y,
+                      Rectangles[1].x,
+                      Rectangles[1].y);
+    }
+}
+
+void a_platform__drawRectanglesOutline(const AVectorInt* Rectangles, unsigned NumRectangles)
+{
+    #if A__TILES
+        if(a_platform_software_tiles__recording) {
+            for(unsigned r = 0; r < NumRectangles; r++, Rectangles += 2) {
+                a_platform__drawRectangleOutline(Rectangles[0].x,
+                                                 Rectangles[0].y,
+                                                 Rectangles[1].x,
+                                                 Rectangles[1].y);
+            }
+
+            return;
+        }
+    #endif
+
+    for(unsigned r = 0; r < NumRectangles; r++, Rectangles += 2) {
+        drawRectangle(Rectangles[0].x,
+                      Rectangles[0].y,
+                      Rectangles[1].x,
+                      Rectangles[1].y);
+    }
+}
+
 static void drawCircle(int X, int Y, int Radius)
 {
     int boxX = X - Radius;
@@ -421,11 +696,251 @@ static void drawCircle(int X, int Y, int Radius)
 
 void a_platform__drawCircleOutline(int X, int Y, int Radius)
 {
+    #if A__TILES
+        if(record(A_TILES__CMD_CIRCLE_OUTLINE,
+                  Y - Radius,
+                  Y + Radius,
+                  X, Y, Radius, 0)) {
+            return;
+        }
+    #endif
+
     drawCircle(X, Y, Radius);
 }
 
 void a_platform__drawCircleFilled(int X, int Y, int Radius)
 {
+    #if A__TILES
+        if(record(A_TILES__CMD_CIRCLE_FILLED,
+                  Y - Radius,
+                  Y + Radius,
+                  X, Y, Radius, 0)) {
+            return;
+        }
+    #endif
+
     drawCircle(X, Y, Radius);
 }
+
+void a_platform__drawEllipseOutline(int X, int Y, int RadiusX, int RadiusY)
+{
+    #if A__TILES
+        if(record(A_TILES__CMD_ELLIPSE_OUTLINE,
+                  Y - RadiusY,
+                  Y + RadiusY,
+                  X, Y, RadiusX, RadiusY)) {
+            return;
+        }
+    #endif
+
+    if(a_screen_boxOnClip(X - RadiusX, Y - RadiusY, 2 * RadiusX, 2 * RadiusY)) {
+        g_draw_ellipse(X, Y, RadiusX, RadiusY);
+    }
+}
+
+void a_platform__drawEllipseFilled(int X, int Y, int RadiusX, int RadiusY)
+{
+    #if A__TILES
+        if(record(A_TILES__CMD_ELLIPSE_FILLED,
+                  Y - RadiusY,
+                  Y + RadiusY,
+                  X, Y, RadiusX, RadiusY)) {
+            return;
+        }
+    #endif
+
+    if(a_screen_boxOnClip(X - RadiusX, Y - RadiusY, 2 * RadiusX, 2 * RadiusY)) {
+        g_draw_ellipse(X, Y, RadiusX, RadiusY);
+    }
+}
+
+// Antialiased primitives blend with rgba, scaling alpha by pixel coverage
+static void drawPixelCoverage(int X, int Y, int Coverage)
+{
+    if(Coverage <= 0
+        || (unsigned)(X - a__screen.clipX) >= (unsigned)a__screen.clipWidth
+        || (unsigned)(Y - a__screen.clipY) >= (unsigned)a__screen.clipHeight) {
+
+        return;
+    }
+
+    a_pixel__rgba(a__screen.pixels + Y * a__screen.width + X,
+                  a_pixel__state.red,
+                  a_pixel__state.green,
+                  a_pixel__state.blue,
+                  (a_pixel__state.alpha * Coverage) >> 8);
+}
+
+void a_platform__drawLineAntialiased(int X1, int Y1, int X2, int Y2)
+{
+    #if A__TILES
+        if(record(A_TILES__CMD_LINE_ANTIALIASED,
+                  a_math_min(Y1, Y2),
+                  a_math_max(Y1, Y2) + 2,
+                  X1, Y1, X2, Y2)) {
+            return;
+        }
+    #endif
+
+    // Wu's algorithm, walk the major axis and split each step between
+    // the two pixels the line passes between
+    const bool steep = a_math_abs(Y2 - Y1) > a_math_abs(X2 - X1);
+
+    if(steep) {
+        A__SWAP(X1, Y1);
+        A__SWAP(X2, Y2);
+    }
+
+    if(X1 > X2) {
+        A__SWAP(X1, X2);
+        A__SWAP(Y1, Y2);
+    }
+
+    const AFix gradient = X1 == X2
+                            ? 0
+                            : a_fix_div(a_fix_fromInt(Y2 - Y1),
+                                        a_fix_fromInt(X2 - X1));
+
+    // Only step through the part of the major axis inside the clip
+    const int start = a_math_max(
+                        X1, steep ? a__screen.clipY : a__screen.clipX);
+    const int end = a_math_min(
+                        X2, (steep ? a__screen.clipY2 : a__screen.clipX2) - 1);
+
+    AFix y = a_fix_fromInt(Y1) + gradient * (start - X1);
+
+    for(int x = start; x <= end; x++, y += gradient) {
+        const int row = a_fix_toInt(y);
+        const int frac = (y & A_FIX_FRACTION_MASK) >> (A_FIX_BIT_PRECISION - 8);
+
+        if(steep) {
+            drawPixelCoverage(row, x, 256 - frac);
+            drawPixelCoverage(row + 1, x, frac);
+        } else {
+            drawPixelCoverage(x, row, 256 - frac);
+            drawPixelCoverage(x, row + 1, frac);
+        }
+    }
+}
+
+static unsigned isqrt(uint64_t X)
+{
+    uint64_t root = 0;
+    uint64_t bit = (uint64_t)1 << 62;
+
+    while(bit > X) {
+        bit >>= 2;
+    }
+
+    while(bit) {
+        if(X >= root + bit) {
+            X -= root + bit;
+            root = (root >> 1) + bit;
+        } else {
+            root >>= 1;
+        }
+
+        bit >>= 2;
+    }
+
+    return (unsigned)root;
+}
+
+static void drawQuadrantsCoverage(int X, int Y, int DX, int DY, int Coverage)
+{
+    drawPixelCoverage(X + DX, Y + DY, Coverage);
+    drawPixelCoverage(X - 1 - DX, Y + DY, Coverage);
+    drawPixelCoverage(X + DX, Y - 1 - DY, Coverage);
+    drawPixelCoverage(X - 1 - DX, Y - 1 - DY, Coverage);
+}
+
+void a_platform__drawCircleAntialiased(int X, int Y, int Radius)
+{
+    #if A__TILES
+        if(record(A_TILES__CMD_CIRCLE_ANTIALIASED,
+                  Y - Radius - 1,
+                  Y + Radius + 1,
+                  X, Y, Radius, 0)) {
+            return;
+        }
+    #endif
+
+    if(Radius <= 0
+        || !a_screen_boxOnClip(
+                X - Radius - 1, Y - Radius - 1, 2 * Radius + 2, 2 * Radius + 2)) {
+
+        return;
+    }
+
+    // Same center as a_draw_circle, between pixels X - 1 and X. Distances
+    // are in 1/256 pixel, pixel centers are half a pixel off the grid.
+    const uint64_t radius2 = (uint64_t)Radius * (uint64_t)Radius << 16;
+
+    for(int dx = 0; ; dx++) {
+        const uint64_t cx = 256 * (uint64_t)dx + 128;
+
+        if(cx * cx > radius2) {
+            break;
+        }
+
+        const int h = (int)isqrt(radius2 - cx * cx) - 128;
+
+        if(h < 0) {
+            break;
+        }
+
+        const int dy = h >> 8;
+        const int frac = h & 0xff;
+
+        if(dy + 1 < dx) {
+            break;
+        }
+
+        // Column steps own the pixels on and above the diagonal, their
+        // mirrored row steps own the ones below it
+        if(dy >= dx) {
+            drawQuadrantsCoverage(X, Y, dx, dy, 256 - frac);
+        }
+
+        drawQuadrantsCoverage(X, Y, dx, dy + 1, frac);
+
+        if(dy > dx) {
+            drawQuadrantsCoverage(X, Y, dy, dx, 256 - frac);
+        }
+
+        if(dy + 1 > dx) {
+            drawQuadrantsCoverage(X, Y, dy + 1, dx, frac);
+        }
+    }
+}
+
+void a_platform__drawTriangleFilled(int X1, int Y1, int X2, int Y2, int X3, int Y3)
+{
+    #if A__TILES
+        if(a_platform_software_tiles__recording) {
+            ATilesCmd* cmd = a_platform_software_tiles__cmdNew(
+                                A_TILES__CMD_TRIANGLE_FILLED, Y1, Y3);
+
+            if(cmd) {
+                cmd->args[0] = X1;
+                cmd->args[1] = Y1;
+                cmd->args[2] = X2;
+                cmd->args[3] = Y2;
+                cmd->args[4] = X3;
+                cmd->args[5] = Y3;
+            }
+
+            return;
+        }
+    #endif
+
+    const int minX = a_math_min(X1, a_math_min(X2, X3));
+    const int maxX = a_math_max(X1, a_math_max(X2, X3));
+
+    if(!a_screen_boxOnClip(minX, Y1, maxX - minX + 1, Y3 - Y1)) {
+        return;
+    }
+
+    g_draw_triangle(X1, Y1, X2, Y2, X3, Y3);
+}
 #endif // A_CONFIG_LIB_RENDER_SOFTWARE
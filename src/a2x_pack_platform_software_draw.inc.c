@@ -23,6 +23,24 @@ static void A__FUNC_NAME(pixel)(int X, int Y)
     A__PIXEL_DRAW(a__screen.pixels + Y * a__screen.width + X);
 }
 
+static void A__FUNC_NAME(pixels)(const AVectorInt* Points, unsigned NumPoints)
+{
+    A__BLEND_SETUP;
+
+    const int screenW = a__screen.width;
+    const unsigned clipW = (unsigned)a__screen.clipWidth;
+    const unsigned clipH = (unsigned)a__screen.clipHeight;
+
+    for( ; NumPoints--; Points++) {
+        // Negative offsets wrap around and fail the test too
+        if((unsigned)(Points->x - a__screen.clipX) < clipW
+            && (unsigned)(Points->y - a__screen.clipY) < clipH) {
+
+            A__PIXEL_DRAW(a__screen.pixels + Points->y * screenW + Points->x);
+        }
+    }
+}
+
 static void A__FUNC_NAME(rectangle_nofill)(int X, int Y, int Width, int Height)
 {
     g_draw_hline(X, X + Width - 1, Y);
@@ -48,11 +66,7 @@ static void A__FUNC_NAME(rectangle_fill)(int X, int Y, int Width, int Height)
     const int screenw = a__screen.width;
 
     for(int i = Height; i--; pixels += screenw) {
-        APixel* dst = pixels;
-
-        for(int j = Width; j--; dst++) {
-            A__PIXEL_DRAW(dst);
-        }
+        A__PIXEL_SPAN(pixels, Width);
     }
 }
 
@@ -125,9 +139,7 @@ static void A__FUNC_NAME(hline)(int X1, int X2, int Y)
 
     APixel* dst = a__screen.pixels + Y * a__screen.width + X1;
 
-    for(int i = X2 - X1 + 1; i--; dst++) {
-        A__PIXEL_DRAW(dst);
-    }
+    A__PIXEL_SPAN(dst, X2 - X1 + 1);
 }
 
 static void A__FUNC_NAME(vline)(int X, int Y1, int Y2)
@@ -229,57 +241,18 @@ static void A__FUNC_NAME(circle_noclip_nofill)(int X, int Y, int Radius)
 
 static void A__FUNC_NAME(circle_noclip_fill)(int X, int Y, int Radius)
 {
+    A__BLEND_SETUP;
+
     if(--Radius <= 0) {
         if(Radius == 0) {
-            g_draw_rectangle(X - 1, Y - 1, 2, 2);
+            drawSpan(X - 1, X, Y - 1);
+            drawSpan(X - 1, X, Y);
         }
 
         return;
     }
 
-    int x = Radius;
-    int y = 0;
-    int error = -Radius / 2;
-
-    int x1 = X - 1 - x;
-    int x2 = X + x;
-    int y1 = Y - 1 - y;
-    int y2 = Y + y;
-    int x3 = X - 1 - y;
-    int x4 = X + y;
-    int y3 = Y - 1 - x;
-    int y4 = Y + x;
-
-    while(x > y) {
-        g_draw_hline(x1, x2, y1);
-        g_draw_hline(x1, x2, y2);
-
-        error += 2 * y + 1; // (y+1)^2 = y^2 + 2y + 1
-        y++;
-
-        y1--;
-        y2++;
-        x3--;
-        x4++;
-
-        if(error > 0) { // check if x^2 + y^2 > r^2
-            g_draw_hline(x3, x4, y3);
-            g_draw_hline(x3, x4, y4);
-
-            error += -2 * x + 1; // (x-1)^2 = x^2 - 2x + 1
-            x--;
-
-            x1++;
-            x2--;
-            y3++;
-            y4--;
-        }
-    }
-
-    if(x == y) {
-        g_draw_hline(x3, x4, y3);
-        g_draw_hline(x3, x4, y4);
-    }
+    drawCircleFilled(X, Y, Radius, drawSpan);
 }
 
 static void A__FUNC_NAME(circle_clip_nofill)(int X, int Y, int Radius)
@@ -474,59 +447,93 @@ static void A__FUNC_NAME(circle_clip_nofill)(int X, int Y, int Radius)
 
 static void A__FUNC_NAME(circle_clip_fill)(int X, int Y, int Radius)
 {
+    A__BLEND_SETUP;
+
     if(--Radius <= 0) {
         if(Radius == 0) {
-            a_draw_rectangle(X - 1, Y - 1, 2, 2);
+            drawSpanClipped(X - 1, X, Y - 1);
+            drawSpanClipped(X - 1, X, Y);
         }
 
         return;
     }
 
-    int x = Radius;
-    int y = 0;
-    int error = -Radius / 2;
+    drawCircleFilled(X, Y, Radius, drawSpanClipped);
+}
 
-    int x1 = X - 1 - x;
-    int x2 = X + x;
-    int y1 = Y - 1 - y;
-    int y2 = Y + y;
-    int x3 = X - 1 - y;
-    int x4 = X + y;
-    int y3 = Y - 1 - x;
-    int y4 = Y + x;
+static void A__FUNC_NAME(ellipse_nofill)(int X, int Y, int RadiusX, int RadiusY)
+{
+    A__BLEND_SETUP;
 
-    while(x > y) {
-        a_draw_hline(x1, x2, y1);
-        a_draw_hline(x1, x2, y2);
+    ADrawEllipseEdge ellipse;
+    a_draw__ellipseInit(&ellipse, RadiusX, RadiusY);
 
-        error += 2 * y + 1; // (y+1)^2 = y^2 + 2y + 1
-        y++;
+    for(int y = 0; y < RadiusY && ellipse.x >= 0; y++) {
+        const int x = ellipse.x;
 
-        y1--;
-        y2++;
-        x3--;
-        x4++;
+        a_draw__ellipseStep(&ellipse);
 
-        if(error > 0) { // check if x^2 + y^2 > r^2
-            a_draw_hline(x3, x4, y3);
-            a_draw_hline(x3, x4, y4);
+        // Columns past the next row's edge have nothing under them
+        const int next = y + 1 < RadiusY ? ellipse.x : -1;
+        const int inner = a_math_min(x, next + 1);
 
-            error += -2 * x + 1; // (x-1)^2 = x^2 - 2x + 1
-            x--;
+        drawSpanClipped(X + inner, X + x, Y + y);
+        drawSpanClipped(X - 1 - x, X - 1 - inner, Y + y);
+        drawSpanClipped(X + inner, X + x, Y - 1 - y);
+        drawSpanClipped(X - 1 - x, X - 1 - inner, Y - 1 - y);
+    }
+}
 
-            x1++;
-            x2--;
-            y3++;
-            y4--;
-        }
+static void A__FUNC_NAME(ellipse_fill)(int X, int Y, int RadiusX, int RadiusY)
+{
+    A__BLEND_SETUP;
+
+    ADrawEllipseEdge ellipse;
+    a_draw__ellipseInit(&ellipse, RadiusX, RadiusY);
+
+    for(int y = 0; y < RadiusY && ellipse.x >= 0; y++) {
+        drawSpanClipped(X - 1 - ellipse.x, X + ellipse.x, Y + y);
+        drawSpanClipped(X - 1 - ellipse.x, X + ellipse.x, Y - 1 - y);
+
+        a_draw__ellipseStep(&ellipse);
     }
+}
 
-    if(x == y) {
-        a_draw_hline(x3, x4, y3);
-        a_draw_hline(x3, x4, y4);
+// Vertices are sorted top to bottom
+static void A__FUNC_NAME(triangle)(int X1, int Y1, int X2, int Y2, int X3, int Y3)
+{
+    A__BLEND_SETUP;
+
+    // Vertex 2 is either right or left of the long edge from 1 to 3
+    const int64_t side = (int64_t)(X2 - X1) * (Y3 - Y1)
+                            - (int64_t)(X3 - X1) * (Y2 - Y1);
+
+    if(side == 0) {
+        return;
+    }
+
+    const int yStart = a_math_max(Y1, a__screen.clipY);
+    const int yEnd = a_math_min(Y3, a__screen.clipY2);
+    const int yMid = a_math_min(a_math_max(Y2, yStart), yEnd);
+
+    ADrawEdge edgeLong, edgeShort;
+    ADrawEdge* left = side > 0 ? &edgeLong : &edgeShort;
+    ADrawEdge* right = side > 0 ? &edgeShort : &edgeLong;
+
+    a_draw__edgeInit(&edgeLong, X1, Y1, X3, Y3, yStart);
+
+    if(yStart < yMid) {
+        a_draw__edgeInit(&edgeShort, X1, Y1, X2, Y2, yStart);
+        drawTriangleRows(yStart, yMid, left, right);
+    }
+
+    if(yMid < yEnd) {
+        a_draw__edgeInit(&edgeShort, X2, Y2, X3, Y3, yMid);
+        drawTriangleRows(yMid, yEnd, left, right);
     }
 }
 
 #undef A__BLEND
 #undef A__BLEND_SETUP
 #undef A__PIXEL_PARAMS
+#undef A__PIXEL_SPAN
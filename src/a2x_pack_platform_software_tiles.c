@@ -0,0 +1,379 @@
+/*
+    Copyright 2019 Alex Margarit <alex@alxm.org>
+    This file is part of a2x, a C video game framework.
+
+    This program is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    This program is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with this program.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#include "a2x_pack_platform_software_tiles.v.h"
+
+#if A__TILES
+#include <pthread.h>
+
+#include "a2x_pack_main.v.h"
+#include "a2x_pack_mem.v.h"
+#include "a2x_pack_platform_software_draw.v.h"
+#include "a2x_pack_screen.v.h"
+
+#define A__TILES_BANDS (A_CONFIG_SCREEN_THREADS + 1)
+
+typedef struct {
+    ATilesCmd* cmds;
+    unsigned num;
+    unsigned capacity;
+} ATilesCmdList;
+
+typedef struct {
+    pthread_mutex_t mutex;
+    pthread_cond_t work;
+    pthread_cond_t done;
+    unsigned generation;
+    unsigned pending;
+    bool quit;
+    AScreen target;
+    int bandHeight;
+    const ATilesCmd* start;
+    const ATilesCmd* end;
+} ATilesJob;
+
+A__THREAD_LOCAL bool a_platform_software_tiles__recording;
+
+static ATilesCmdList g_list;
+static ATilesJob g_job;
+static pthread_t g_workers[A_CONFIG_SCREEN_THREADS];
+
+static void cmdRun(const ATilesCmd* Cmd)
+{
+    switch(Cmd->type) {
+        case A_TILES__CMD_BLIT: {
+            a_platform__textureBlit(Cmd->texture,
+                                    Cmd->args[0],
+                                    Cmd->args[1],
+                                    Cmd->fillFlat);
+        } break;
+
+        case A_TILES__CMD_BLITEX: {
+            a_platform__textureBlitEx(Cmd->texture,
+                                      Cmd->args[0],
+                                      Cmd->args[1],
+                                      Cmd->scale,
+                                      Cmd->angle,
+                                      Cmd->args[2],
+                                      Cmd->args[3],
+                                      Cmd->fillFlat);
+        } break;
+
+        case A_TILES__CMD_PIXEL: {
+            a_platform__drawPixel(Cmd->args[0], Cmd->args[1]);
+        } break;
+
+        case A_TILES__CMD_LINE: {
+            a_platform__drawLine(
+                Cmd->args[0], Cmd->args[1], Cmd->args[2], Cmd->args[3]);
+        } break;
+
+        case A_TILES__CMD_LINE_ANTIALIASED: {
+            a_platform__drawLineAntialiased(
+                Cmd->args[0], Cmd->args[1], Cmd->args[2], Cmd->args[3]);
+        } break;
+
+        case A_TILES__CMD_HLINE: {
+            a_platform__drawHLine(Cmd->args[0], Cmd->args[1], Cmd->args[2]);
+        } break;
+
+        case A_TILES__CMD_VLINE: {
+            a_platform__drawVLine(Cmd->args[0], Cmd->args[1], Cmd->args[2]);
+        } break;
+
+        case A_TILES__CMD_RECTANGLE_FILLED: {
+            a_platform__drawRectangleFilled(
+                Cmd->args[0], Cmd->args[1], Cmd->args[2], Cmd->args[3]);
+        } break;
+
+        case A_TILES__CMD_RECTANGLE_OUTLINE: {
+            a_platform__drawRectangleOutline(
+                Cmd->args[0], Cmd->args[1], Cmd->args[2], Cmd->args[3]);
+        } break;
+
+        case A_TILES__CMD_CIRCLE_OUTLINE: {
+            a_platform__drawCircleOutline(
+                Cmd->args[0], Cmd->args[1], Cmd->args[2]);
+        } break;
+
+        case A_TILES__CMD_CIRCLE_FILLED: {
+            a_platform__drawCircleFilled(
+                Cmd->args[0], Cmd->args[1], Cmd->args[2]);
+        } break;
+
+        case A_TILES__CMD_CIRCLE_ANTIALIASED: {
+            a_platform__drawCircleAntialiased(
+                Cmd->args[0], Cmd->args[1], Cmd->args[2]);
+        } break;
+
+        case A_TILES__CMD_ELLIPSE_OUTLINE: {
+            a_platform__drawEllipseOutline(
+                Cmd->args[0], Cmd->args[1], Cmd->args[2], Cmd->args[3]);
+        } break;
+
+        case A_TILES__CMD_ELLIPSE_FILLED: {
+            a_platform__drawEllipseFilled(
+                Cmd->args[0], Cmd->args[1], Cmd->args[2], Cmd->args[3]);
+        } break;
+
+        case A_TILES__CMD_TRIANGLE_FILLED: {
+            a_platform__drawTriangleFilled(Cmd->args[0],
+                                           Cmd->args[1],
+                                           Cmd->args[2],
+                                           Cmd->args[3],
+                                           Cmd->args[4],
+                                           Cmd->args[5]);
+        } break;
+    }
+}
+
+// Replay the commands that touch rows [Y, Y2) with the clip narrowed to them
+static void rowsRun(const ATilesCmd* Start, const ATilesCmd* End, const AScreen* Target, int Y, int Y2)
+{
+    APixelBlend blend = A_PIXEL_BLEND_INVALID;
+    bool fillDraw = false;
+
+    a__screen = *Target;
+
+    for(const ATilesCmd* cmd = Start; cmd < End; cmd++) {
+        if(cmd->y >= Y2 || cmd->y2 <= Y) {
+            continue;
+        }
+
+        a__screen.clipX = cmd->clipX;
+        a__screen.clipY = a_math_max(cmd->clipY, Y);
+        a__screen.clipX2 = cmd->clipX2;
+        a__screen.clipY2 = a_math_min(cmd->clipY2, Y2);
+        a__screen.clipWidth = a__screen.clipX2 - a__screen.clipX;
+        a__screen.clipHeight = a__screen.clipY2 - a__screen.clipY;
+
+        a_pixel__state = cmd->pixel;
+
+        if(blend != cmd->pixel.blend || fillDraw != cmd->pixel.fillDraw) {
+            blend = cmd->pixel.blend;
+            fillDraw = cmd->pixel.fillDraw;
+
+            a_platform_software_draw__updateRoutines();
+        }
+
+        cmdRun(cmd);
+    }
+}
+
+static void bandRun(int Band)
+{
+    int y = Band * g_job.bandHeight;
+    int y2 = a_math_min(y + g_job.bandHeight, g_job.target.height);
+
+    if(y < y2) {
+        rowsRun(g_job.start, g_job.end, &g_job.target, y, y2);
+    }
+}
+
+static void* workerMain(void* Band)
+{
+    unsigned generation = 0;
+
+    while(true) {
+        pthread_mutex_lock(&g_job.mutex);
+
+        while(g_job.generation == generation && !g_job.quit) {
+            pthread_cond_wait(&g_job.work, &g_job.mutex);
+        }
+
+        if(g_job.quit) {
+            pthread_mutex_unlock(&g_job.mutex);
+            break;
+        }
+
+        generation = g_job.generation;
+        pthread_mutex_unlock(&g_job.mutex);
+
+        bandRun((int)(intptr_t)Band);
+
+        pthread_mutex_lock(&g_job.mutex);
+
+        if(--g_job.pending == 0) {
+            pthread_cond_signal(&g_job.done);
+        }
+
+        pthread_mutex_unlock(&g_job.mutex);
+    }
+
+    return NULL;
+}
+
+static void parallelRun(const ATilesCmd* Start, const ATilesCmd* End)
+{
+    if(Start == End) {
+        return;
+    }
+
+    pthread_mutex_lock(&g_job.mutex);
+
+    g_job.start = Start;
+    g_job.end = End;
+    g_job.pending = A_CONFIG_SCREEN_THREADS;
+    g_job.generation++;
+
+    pthread_cond_broadcast(&g_job.work);
+    pthread_mutex_unlock(&g_job.mutex);
+
+    bandRun(0);
+
+    pthread_mutex_lock(&g_job.mutex);
+
+    while(g_job.pending > 0) {
+        pthread_cond_wait(&g_job.done, &g_job.mutex);
+    }
+
+    pthread_mutex_unlock(&g_job.mutex);
+}
+
+// Clipping outlines and lines to a band changes which pixels they draw
+static bool cmdIsSerial(const ATilesCmd* Cmd, int BandHeight)
+{
+    if(Cmd->y / BandHeight == (Cmd->y2 - 1) / BandHeight) {
+        return false;
+    }
+
+    switch(Cmd->type) {
+        case A_TILES__CMD_LINE:
+            return true;
+
+        case A_TILES__CMD_RECTANGLE_FILLED:
+        case A_TILES__CMD_RECTANGLE_OUTLINE:
+        case A_TILES__CMD_CIRCLE_OUTLINE:
+        case A_TILES__CMD_CIRCLE_FILLED:
+            return !Cmd->pixel.fillDraw;
+
+        default:
+            return false;
+    }
+}
+
+void a_platform_software_tiles__init(void)
+{
+    pthread_mutex_init(&g_job.mutex, NULL);
+    pthread_cond_init(&g_job.work, NULL);
+    pthread_cond_init(&g_job.done, NULL);
+
+    for(int t = 0; t < A_CONFIG_SCREEN_THREADS; t++) {
+        if(pthread_create(
+            &g_workers[t], NULL, workerMain, (void*)(intptr_t)(t + 1)) != 0) {
+
+            A__FATAL("a_platform_software_tiles__init: pthread_create failed");
+        }
+    }
+
+    a_platform_software_tiles__recording = true;
+}
+
+void a_platform_software_tiles__uninit(void)
+{
+    a_platform_software_tiles__recording = false;
+
+    pthread_mutex_lock(&g_job.mutex);
+    g_job.quit = true;
+    pthread_cond_broadcast(&g_job.work);
+    pthread_mutex_unlock(&g_job.mutex);
+
+    for(int t = 0; t < A_CONFIG_SCREEN_THREADS; t++) {
+        pthread_join(g_workers[t], NULL);
+    }
+
+    pthread_cond_destroy(&g_job.done);
+    pthread_cond_destroy(&g_job.work);
+    pthread_mutex_destroy(&g_job.mutex);
+
+    a_mem_free(g_list.cmds);
+}
+
+ATilesCmd* a_platform_software_tiles__cmdNew(ATilesCmdType Type, int Y, int Y2)
+{
+    Y = a_math_max(Y, a__screen.clipY);
+    Y2 = a_math_min(Y2, a__screen.clipY2);
+
+    if(Y >= Y2 || a__screen.clipWidth <= 0) {
+        return NULL;
+    }
+
+    if(g_list.num == g_list.capacity) {
+        unsigned capacity = g_list.capacity < 256 ? 256 : g_list.capacity * 2;
+        ATilesCmd* cmds = a_mem_malloc(capacity * sizeof(ATilesCmd));
+
+        if(g_list.cmds) {
+            memcpy(cmds, g_list.cmds, g_list.num * sizeof(ATilesCmd));
+            a_mem_free(g_list.cmds);
+        }
+
+        g_list.cmds = cmds;
+        g_list.capacity = capacity;
+    }
+
+    ATilesCmd* cmd = &g_list.cmds[g_list.num++];
+
+    cmd->type = Type;
+    cmd->y = Y;
+    cmd->y2 = Y2;
+    cmd->clipX = a__screen.clipX;
+    cmd->clipY = a__screen.clipY;
+    cmd->clipX2 = a__screen.clipX2;
+    cmd->clipY2 = a__screen.clipY2;
+    cmd->pixel = a_pixel__state;
+
+    return cmd;
+}
+
+void a_platform_software_tiles__flush(void)
+{
+    if(g_list.num == 0 || !a_platform_software_tiles__recording) {
+        return;
+    }
+
+    const AScreen screen = a__screen;
+    const APixelState pixel = a_pixel__state;
+
+    a_platform_software_tiles__recording = false;
+
+    g_job.target = screen;
+    g_job.bandHeight =
+        a_math_max(1, (screen.height + A__TILES_BANDS - 1) / A__TILES_BANDS);
+
+    const ATilesCmd* start = g_list.cmds;
+    const ATilesCmd* end = g_list.cmds + g_list.num;
+
+    for(const ATilesCmd* cmd = start; cmd < end; cmd++) {
+        if(cmdIsSerial(cmd, g_job.bandHeight)) {
+            parallelRun(start, cmd);
+            rowsRun(cmd, cmd + 1, &screen, 0, screen.height);
+            start = cmd + 1;
+        }
+    }
+
+    parallelRun(start, end);
+
+    g_list.num = 0;
+
+    a__screen = screen;
+    a_pixel__state = pixel;
+    a_platform_software_draw__updateRoutines();
+
+    a_platform_software_tiles__recording = true;
+}
+#endif // A__TILES
@@ -0,0 +1,67 @@
+/*
+    Copyright 2019 Alex Margarit <alex@alxm.org>
+    This file is part of a2x, a C video game framework.
+
+    This program is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    This program is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with this program.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#pragma once
+
+#include "a2x_pack_platform_software_tiles.p.h"
+
+#define A__TILES (A_CONFIG_LIB_RENDER_SOFTWARE && A_CONFIG_SCREEN_THREADS > 0)
+
+#if A__TILES
+#include "a2x_pack_fix.v.h"
+#include "a2x_pack_pixel.v.h"
+#include "a2x_pack_platform.v.h"
+
+typedef enum {
+    A_TILES__CMD_BLIT,
+    A_TILES__CMD_BLITEX,
+    A_TILES__CMD_PIXEL,
+    A_TILES__CMD_LINE,
+    A_TILES__CMD_LINE_ANTIALIASED,
+    A_TILES__CMD_HLINE,
+    A_TILES__CMD_VLINE,
+    A_TILES__CMD_RECTANGLE_FILLED,
+    A_TILES__CMD_RECTANGLE_OUTLINE,
+    A_TILES__CMD_CIRCLE_OUTLINE,
+    A_TILES__CMD_CIRCLE_FILLED,
+    A_TILES__CMD_CIRCLE_ANTIALIASED,
+    A_TILES__CMD_ELLIPSE_OUTLINE,
+    A_TILES__CMD_ELLIPSE_FILLED,
+    A_TILES__CMD_TRIANGLE_FILLED
+} ATilesCmdType;
+
+typedef struct {
+    ATilesCmdType type;
+    int y, y2; // rows the command may touch, clipped
+    int clipX, clipY, clipX2, clipY2;
+    APixelState pixel;
+    const APlatformTexture* texture;
+    int args[6];
+    AFix scale;
+    unsigned angle;
+    bool fillFlat;
+} ATilesCmd;
+
+extern A__THREAD_LOCAL bool a_platform_software_tiles__recording;
+
+extern void a_platform_software_tiles__init(void);
+extern void a_platform_software_tiles__uninit(void);
+
+extern ATilesCmd* a_platform_software_tiles__cmdNew(ATilesCmdType Type, int Y, int Y2);
+extern void a_platform_software_tiles__flush(void);
+#endif
@@ -38,15 +38,21 @@ static void readFunction(png_structp Png, png_bytep Data, png_size_t Length)
     stream->offset += Length;
 }
 
-static void pngToPixels(png_structp Png, png_infop Info, APixel** Pixels, int* Width, int* Height)
+static void pngToPixels(png_structp Png, png_infop Info, APixel** Pixels, uint8_t** Alpha, int* Width, int* Height)
 {
     png_uint_32 w = png_get_image_width(Png, Info);
     png_uint_32 h = png_get_image_height(Png, Info);
     unsigned numChannels = png_get_channels(Png, Info);
 
     APixel* pixels = a_mem_malloc(w * h * sizeof(APixel));
+    uint8_t* alpha = NULL;
     png_bytepp rows = png_get_rows(Png, Info);
 
+    if(Alpha && numChannels == 4) {
+        alpha = a_mem_malloc(w * h);
+        *Alpha = alpha;
+    }
+
     *Width = (int)w;
     *Height = (int)h;
     *Pixels = pixels;
@@ -56,11 +62,20 @@ static void pngToPixels(png_structp Png, png_infop Info, APixel** Pixels, int* W
             *pixels++ = a_pixel_fromRgb(rows[0][chOffset + 0],
                                         rows[0][chOffset + 1],
                                         rows[0][chOffset + 2]);
+
+            if(alpha) {
+                *alpha++ = rows[0][chOffset + 3];
+            }
         }
     }
 }
 
 void a_png_readFile(const char* Path, APixel** Pixels, int* Width, int* Height)
+{
+    a_png_readFileEx(Path, Pixels, NULL, Width, Height);
+}
+
+void a_png_readFileEx(const char* Path, APixel** Pixels, uint8_t** Alpha, int* Width, int* Height)
 {
     png_structp png = NULL;
     png_infop info = NULL;
@@ -72,7 +87,8 @@ void a_png_readFile(const char* Path, APixel** Pixels, int* Width, int* Height)
     }
 
     if(a_path_test(a_file_pathGet(f), A_PATH_EMBEDDED)) {
-        a_png_readMemory(a_file__dataGet(f)->buffer, Pixels, Width, Height);
+        a_png_readMemoryEx(
+            a_file__dataGet(f)->buffer, Pixels, Alpha, Width, Height);
         goto cleanUp;
     }
 
@@ -113,7 +129,7 @@ void a_png_readFile(const char* Path, APixel** Pixels, int* Width, int* Height)
         goto cleanUp;
     }
 
-    pngToPixels(png, info, Pixels, Width, Height);
+    pngToPixels(png, info, Pixels, Alpha, Width, Height);
 
 cleanUp:
     if(png) {
@@ -124,6 +140,11 @@ cleanUp:
 }
 
 void a_png_readMemory(const uint8_t* Data, APixel** Pixels, int* Width, int* Height)
+{
+    a_png_readMemoryEx(Data, Pixels, NULL, Width, Height);
+}
+
+void a_png_readMemoryEx(const uint8_t* Data, APixel** Pixels, uint8_t** Alpha, int* Width, int* Height)
 {
     AByteStream* stream = a_mem_malloc(sizeof(AByteStream));
 
@@ -169,14 +190,14 @@ void a_png_readMemory(const uint8_t* Data, APixel** Pixels, int* Width, int* Hei
         goto cleanUp;
     }
 
-    pngToPixels(png, info, Pixels, Width, Height);
+    pngToPixels(png, info, Pixels, Alpha, Width, Height);
 
 cleanUp:
     if(png) {
         png_destroy_read_struct(&png, info ? &info : NULL, NULL);
     }
 
-    free(stream);
+    a_mem_free(stream);
 }
 
 void a_png_write(const char* Path, const APixel* Data, int Width, int Height, char* Title, char* Description)
@@ -265,8 +286,8 @@ cleanUp:
         png_destroy_write_struct(&png, info ? &info : NULL);
     }
 
-    free(rows);
-    free(rowsData);
+    a_mem_free(rows);
+    a_mem_free(rowsData);
 
     a_file_free(f);
 }
@@ -23,5 +23,7 @@
 #include "a2x_pack_pixel.p.h"
 
 extern void a_png_readFile(const char* Path, APixel** Pixels, int* Width, int* Height);
+extern void a_png_readFileEx(const char* Path, APixel** Pixels, uint8_t** Alpha, int* Width, int* Height);
 extern void a_png_readMemory(const uint8_t* Data, APixel** Pixels, int* Width, int* Height);
+extern void a_png_readMemoryEx(const uint8_t* Data, APixel** Pixels, uint8_t** Alpha, int* Width, int* Height);
 extern void a_png_write(const char* Path, const APixel* Data, int Width, int Height, char* Title, char* Description);
@@ -0,0 +1,290 @@
+/*
+    Copyright 2019 Alex Margarit <alex@alxm.org>
+    This file is part of a2x, a C video game framework.
+
+    This program is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    This program is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with this program.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#include "a2x_pack_ring.v.h"
+
+#include "a2x_pack_main.v.h"
+#include "a2x_pack_math.v.h"
+#include "a2x_pack_mem.v.h"
+
+#define A_RING__CACHE_LINE 64
+
+/*
+    Items are copied in and out by value. Indexes are free-running counters,
+    and the slot for index i is (i & mask), so capacity is a power of two.
+
+    Single producer: the producer owns head, the consumer owns tail, and each
+    side keeps a cached copy of the other's index to avoid touching the
+    shared cache line on every call.
+
+    Multiple producers: producers reserve slots by advancing head with a CAS,
+    then publish each slot by writing i + 1 to its ready counter, since they
+    may finish out of order. The single consumer waits on ready counters.
+*/
+typedef union {
+    struct {
+        unsigned head; // next index to write
+        unsigned tailCache; // producer's last view of tail
+    } v;
+    uint8_t padding[A_RING__CACHE_LINE];
+} ARingProducer;
+
+typedef union {
+    struct {
+        unsigned tail; // next index to read
+        unsigned headCache; // consumer's last view of head
+    } v;
+    uint8_t padding[A_RING__CACHE_LINE];
+} ARingConsumer;
+
+struct ARing {
+    ARingProducer producer;
+    ARingConsumer consumer;
+    unsigned capacity;
+    unsigned mask;
+    size_t itemSize;
+    unsigned* ready; // per-slot publish counters, multi-producer only
+    uint8_t* items;
+};
+
+#if defined(__ATOMIC_ACQUIRE)
+    #define A_RING__LOAD_RELAXED(Ptr) __atomic_load_n(Ptr, __ATOMIC_RELAXED)
+    #define A_RING__LOAD_ACQUIRE(Ptr) __atomic_load_n(Ptr, __ATOMIC_ACQUIRE)
+    #define A_RING__STORE_RELEASE(Ptr, Val) \
+        __atomic_store_n(Ptr, Val, __ATOMIC_RELEASE)
+    #define A_RING__CAS(Ptr, Expected, Desired)                        \
+        __atomic_compare_exchange_n(Ptr, Expected, Desired, true,      \
+                                    __ATOMIC_ACQ_REL, __ATOMIC_RELAXED)
+#else
+    static inline unsigned a_ring__load(const unsigned* Ptr)
+    {
+        unsigned v = *(const volatile unsigned*)Ptr;
+        __sync_synchronize();
+
+        return v;
+    }
+
+    static inline bool a_ring__cas(unsigned* Ptr, unsigned* Expected, unsigned Desired)
+    {
+        unsigned old = __sync_val_compare_and_swap(Ptr, *Expected, Desired);
+
+        if(old == *Expected) {
+            return true;
+        }
+
+        *Expected = old;
+
+        return false;
+    }
+
+    #define A_RING__LOAD_RELAXED(Ptr) (*(const volatile unsigned*)(Ptr))
+    #define A_RING__LOAD_ACQUIRE(Ptr) a_ring__load(Ptr)
+    #define A_RING__STORE_RELEASE(Ptr, Val) \
+        (__sync_synchronize(), *(volatile unsigned*)(Ptr) = (Val))
+    #define A_RING__CAS(Ptr, Expected, Desired) \
+        a_ring__cas(Ptr, Expected, Desired)
+#endif
+
+ARing* a_ring_new(unsigned Capacity, size_t ItemSize, bool MultiProducer)
+{
+    if(Capacity == 0 || Capacity > UINT_MAX / 2 + 1 || ItemSize == 0) {
+        A__FATAL("a_ring_new(%u, %u): Invalid size", Capacity, (unsigned)ItemSize);
+    }
+
+    unsigned capacity = 1;
+
+    while(capacity < Capacity) {
+        capacity <<= 1;
+    }
+
+    ARing* r = a_mem_zalloc(sizeof(ARing));
+
+    r->capacity = capacity;
+    r->mask = capacity - 1;
+    r->itemSize = ItemSize;
+    r->items = a_mem_malloc(capacity * ItemSize);
+
+    if(MultiProducer) {
+        r->ready = a_mem_zalloc(capacity * sizeof(unsigned));
+    }
+
+    return r;
+}
+
+void a_ring_free(ARing* Ring)
+{
+    if(Ring == NULL) {
+        return;
+    }
+
+    a_mem_free(Ring->ready);
+    a_mem_free(Ring->items);
+    a_mem_free(Ring);
+}
+
+static void copyIn(ARing* Ring, unsigned Index, const uint8_t* Items, unsigned NumItems)
+{
+    unsigned slot = Index & Ring->mask;
+    unsigned first = a_math_minu(NumItems, Ring->capacity - slot);
+
+    memcpy(Ring->items + slot * Ring->itemSize, Items, first * Ring->itemSize);
+
+    if(first < NumItems) {
+        memcpy(Ring->items,
+               Items + first * Ring->itemSize,
+               (NumItems - first) * Ring->itemSize);
+    }
+}
+
+static void copyOut(const ARing* Ring, unsigned Index, uint8_t* Items, unsigned NumItems)
+{
+    unsigned slot = Index & Ring->mask;
+    unsigned first = a_math_minu(NumItems, Ring->capacity - slot);
+
+    memcpy(Items, Ring->items + slot * Ring->itemSize, first * Ring->itemSize);
+
+    if(first < NumItems) {
+        memcpy(Items + first * Ring->itemSize,
+               Ring->items,
+               (NumItems - first) * Ring->itemSize);
+    }
+}
+
+static unsigned reserveSingle(ARing* Ring, unsigned NumItems, unsigned* Index)
+{
+    unsigned head = Ring->producer.v.head;
+    unsigned space = Ring->capacity - (head - Ring->producer.v.tailCache);
+
+    if(space < NumItems) {
+        Ring->producer.v.tailCache =
+            A_RING__LOAD_ACQUIRE(&Ring->consumer.v.tail);
+
+        space = Ring->capacity - (head - Ring->producer.v.tailCache);
+    }
+
+    *Index = head;
+
+    return a_math_minu(NumItems, space);
+}
+
+static unsigned reserveMulti(ARing* Ring, unsigned NumItems, unsigned* Index)
+{
+    unsigned head = A_RING__LOAD_RELAXED(&Ring->producer.v.head);
+
+    while(true) {
+        unsigned tail = A_RING__LOAD_ACQUIRE(&Ring->consumer.v.tail);
+        unsigned num = a_math_minu(NumItems, Ring->capacity - (head - tail));
+
+        if(num == 0) {
+            return 0;
+        }
+
+        if(A_RING__CAS(&Ring->producer.v.head, &head, head + num)) {
+            *Index = head;
+
+            return num;
+        }
+    }
+}
+
+unsigned a_ring_pushBatch(ARing* Ring, const void* Items, unsigned NumItems)
+{
+    unsigned index;
+    unsigned num = Ring->ready
+                    ? reserveMulti(Ring, NumItems, &index)
+                    : reserveSingle(Ring, NumItems, &index);
+
+    if(num == 0) {
+        return 0;
+    }
+
+    copyIn(Ring, index, Items, num);
+
+    if(Ring->ready) {
+        for(unsigned i = 0; i < num; i++) {
+            A_RING__STORE_RELEASE(&Ring->ready[(index + i) & Ring->mask],
+                                  index + i + 1);
+        }
+    } else {
+        A_RING__STORE_RELEASE(&Ring->producer.v.head, index + num);
+    }
+
+    return num;
+}
+
+bool a_ring_push(ARing* Ring, const void* Item)
+{
+    return a_ring_pushBatch(Ring, Item, 1) == 1;
+}
+
+unsigned a_ring_popBatch(ARing* Ring, void* Items, unsigned MaxItems)
+{
+    unsigned tail = Ring->consumer.v.tail;
+    unsigned num = 0;
+
+    if(Ring->ready) {
+        // Stop at the first slot that was reserved but not published yet
+        while(num < MaxItems
+            && A_RING__LOAD_ACQUIRE(&Ring->ready[(tail + num) & Ring->mask])
+                == tail + num + 1) {
+
+            num++;
+        }
+    } else {
+        unsigned avail = Ring->consumer.v.headCache - tail;
+
+        if(avail < MaxItems) {
+            Ring->consumer.v.headCache =
+                A_RING__LOAD_ACQUIRE(&Ring->producer.v.head);
+
+            avail = Ring->consumer.v.headCache - tail;
+        }
+
+        num = a_math_minu(MaxItems, avail);
+    }
+
+    if(num == 0) {
+        return 0;
+    }
+
+    copyOut(Ring, tail, Items, num);
+    A_RING__STORE_RELEASE(&Ring->consumer.v.tail, tail + num);
+
+    return num;
+}
+
+bool a_ring_pop(ARing* Ring, void* Item)
+{
+    return a_ring_popBatch(Ring, Item, 1) == 1;
+}
+
+unsigned a_ring_capacityGet(const ARing* Ring)
+{
+    return Ring->capacity;
+}
+
+unsigned a_ring_sizeGet(const ARing* Ring)
+{
+    return A_RING__LOAD_ACQUIRE(&Ring->producer.v.head)
+            - A_RING__LOAD_ACQUIRE(&Ring->consumer.v.tail);
+}
+
+bool a_ring_isEmpty(const ARing* Ring)
+{
+    return a_ring_sizeGet(Ring) == 0;
+}
@@ -0,0 +1,36 @@
+/*
+    Copyright 2019 Alex Margarit <alex@alxm.org>
+    This file is part of a2x, a C video game framework.
+
+    This program is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    This program is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with this program.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#pragma once
+
+#include "a2x_system_includes.h"
+
+typedef struct ARing ARing;
+
+extern ARing* a_ring_new(unsigned Capacity, size_t ItemSize, bool MultiProducer);
+extern void a_ring_free(ARing* Ring);
+
+extern bool a_ring_push(ARing* Ring, const void* Item);
+extern unsigned a_ring_pushBatch(ARing* Ring, const void* Items, unsigned NumItems);
+
+extern bool a_ring_pop(ARing* Ring, void* Item);
+extern unsigned a_ring_popBatch(ARing* Ring, void* Items, unsigned MaxItems);
+
+extern unsigned a_ring_capacityGet(const ARing* Ring);
+extern unsigned a_ring_sizeGet(const ARing* Ring);
+extern bool a_ring_isEmpty(const ARing* Ring);
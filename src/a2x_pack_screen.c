@@ -24,8 +24,11 @@
 #include "a2x_pack_mem.v.h"
 #include "a2x_pack_out.v.h"
 #include "a2x_pack_pixel.v.h"
+#include "a2x_pack_pixel_simd.v.h"
+#include "a2x_pack_platform_software_blit.v.h"
+#include "a2x_pack_platform_software_tiles.v.h"
 
-AScreen a__screen;
+A__THREAD_LOCAL AScreen a__screen;
 static AList* g_stack; // list of AScreen
 static int g_zoom = A_CONFIG_SCREEN_ZOOM;
 static bool g_fullscreen = A_CONFIG_SCREEN_FULLSCREEN;
@@ -38,6 +41,16 @@ static bool g_fullscreen = A_CONFIG_SCREEN_FULLSCREEN;
 
 #endif
 
+#if A__SCREEN_DIRTY
+    static struct {
+        AScreenRect rects[A__SCREEN_DIRTY_NUM]; // disjoint, clipped
+        unsigned num;
+        bool all;
+    } g_dirty;
+
+    static A__THREAD_LOCAL bool g_dirtyTrack; // drawing to the display
+#endif
+
 static void initScreen(AScreen* Screen, int Width, int Height, bool AllocBuffer)
 {
     Screen->pixelsSize = (unsigned)Width * (unsigned)Height * sizeof(APixel);
@@ -64,7 +77,7 @@ static void initScreen(AScreen* Screen, int Width, int Height, bool AllocBuffer)
 static void freeScreen(AScreen* Screen)
 {
     if(Screen->ownsBuffer) {
-        free(Screen->pixels);
+        a_mem_free(Screen->pixels);
     }
 
     #if !A_CONFIG_LIB_RENDER_SOFTWARE
@@ -124,6 +137,11 @@ void a_screen__init(void)
     #endif
 
     g_stack = a_list_new();
+
+    #if A__SCREEN_DIRTY
+        g_dirty.all = true;
+        g_dirtyTrack = true;
+    #endif
 }
 
 void a_screen__uninit(void)
@@ -167,7 +185,16 @@ void a_screen__draw(void)
         A__FATAL("Screen target stack is not empty");
     }
 
+    #if A__TILES
+        a_platform_software_tiles__flush();
+    #endif
+
     a_platform__screenShow();
+
+    #if A__SCREEN_DIRTY
+        g_dirty.num = 0;
+        g_dirty.all = false;
+    #endif
 }
 
 int a_screen__zoomGet(void)
@@ -180,6 +207,7 @@ void a_screen__zoomSet(int Zoom)
     g_zoom = Zoom;
 
     a_platform__screenZoomSet(Zoom);
+    a_screen__dirtyAll();
 }
 
 void a_screen_fullscreenFlip(void)
@@ -187,6 +215,7 @@ void a_screen_fullscreenFlip(void)
     g_fullscreen = !g_fullscreen;
 
     a_platform__screenFullscreenSet(g_fullscreen);
+    a_screen__dirtyAll();
 }
 
 bool a_screen__sameSize(const AScreen* Screen1, const AScreen* Screen2)
@@ -195,8 +224,114 @@ bool a_screen__sameSize(const AScreen* Screen1, const AScreen* Screen2)
         && Screen1->height == Screen2->height;
 }
 
+#if A__SCREEN_DIRTY
+static void dirtyRectAdd(int X, int Y, int Width, int Height)
+{
+    if(!g_dirtyTrack || g_dirty.all) {
+        return;
+    }
+
+    int x = a_math_max(X, a__screen.clipX);
+    int y = a_math_max(Y, a__screen.clipY);
+    int x2 = a_math_min(X + Width, a__screen.clipX2);
+    int y2 = a_math_min(Y + Height, a__screen.clipY2);
+
+    if(x >= x2 || y >= y2) {
+        return;
+    }
+
+    // Absorb every rect that overlaps or touches the new one
+    for(unsigned i = 0; i < g_dirty.num; ) {
+        const AScreenRect* r = &g_dirty.rects[i];
+
+        if(x > r->x + r->w || x2 < r->x || y > r->y + r->h || y2 < r->y) {
+            i++;
+            continue;
+        }
+
+        x = a_math_min(x, r->x);
+        y = a_math_min(y, r->y);
+        x2 = a_math_max(x2, r->x + r->w);
+        y2 = a_math_max(y2, r->y + r->h);
+
+        g_dirty.rects[i] = g_dirty.rects[--g_dirty.num];
+        i = 0;
+    }
+
+    if(g_dirty.num == A__SCREEN_DIRTY_NUM) {
+        a_screen__dirtyAll();
+        return;
+    }
+
+    if((x2 - x) * (y2 - y) * 4 >= a__screen.width * a__screen.height * 3) {
+        a_screen__dirtyAll();
+        return;
+    }
+
+    g_dirty.rects[g_dirty.num++] = (AScreenRect){x, y, x2 - x, y2 - y};
+}
+#endif
+
+#if A_CONFIG_LIB_RENDER_SOFTWARE
+void a_screen__dirtyAdd(int X, int Y, int Width, int Height)
+{
+    if(a__screen.sprite) {
+        a_platform_software_blit__textureDirty(
+            a__screen.sprite->texture,
+            a_math_max(Y, a__screen.clipY),
+            a_math_min(Y + Height, a__screen.clipY2));
+
+        return;
+    }
+
+    #if A__SCREEN_DIRTY
+        dirtyRectAdd(X, Y, Width, Height);
+    #else
+        A_UNUSED(X);
+        A_UNUSED(Width);
+    #endif
+}
+
+void a_screen__dirtyAll(void)
+{
+    if(a__screen.sprite) {
+        a_platform_software_blit__textureDirty(
+            a__screen.sprite->texture, 0, a__screen.height);
+
+        return;
+    }
+
+    #if A__SCREEN_DIRTY
+        if(g_dirtyTrack) {
+            g_dirty.all = true;
+        }
+    #endif
+}
+#endif
+
+#if A__SCREEN_DIRTY
+const AScreenRect* a_screen__dirtyGet(unsigned* Num)
+{
+    if(g_dirty.all) {
+        g_dirty.rects[0] =
+            (AScreenRect){0, 0, a__screen.width, a__screen.height};
+        g_dirty.num = 1;
+    }
+
+    *Num = g_dirty.num;
+
+    return g_dirty.rects;
+}
+#endif
+
 APixel* a_screen_pixelsGetBuffer(void)
 {
+    #if A__TILES
+        a_platform_software_tiles__flush();
+    #endif
+
+    a_screen__dirtyAll();
+
     #if !A_CONFIG_LIB_RENDER_SOFTWARE
         if(a__screen.pixels == NULL) {
             a__screen.pixels = a_mem_malloc(a__screen.pixelsSize);
@@ -253,11 +388,15 @@ void a_screen_free(AScreen* Screen)
     }
 
     freeScreen(Screen);
-    free(Screen);
+    a_mem_free(Screen);
 }
 
 void a_screen_copy(AScreen* Dst, const AScreen* Src)
 {
+    #if A__TILES
+        a_platform_software_tiles__flush();
+    #endif
+
     if(!a_screen__sameSize(Dst, Src)) {
         A__FATAL("a_screen_copy(%dx%d, %dx%d): Different sizes",
                  Dst->width,
@@ -289,6 +428,10 @@ void a_screen_copy(AScreen* Dst, const AScreen* Src)
 
 void a_screen_blit(const AScreen* Screen)
 {
+    #if A__TILES
+        a_platform_software_tiles__flush();
+    #endif
+
     if(!a_screen__sameSize(&a__screen, Screen)) {
         A__FATAL("a_screen_blit(%dx%d): Current screen is %dx%d",
                  Screen->width,
@@ -297,14 +440,19 @@ void a_screen_blit(const AScreen* Screen)
                  a__screen.height);
     }
 
+    a_screen__dirtyAdd(0, 0, a__screen.width, a__screen.height);
+
     #if A_CONFIG_LIB_RENDER_SOFTWARE
         bool noClipping = a_screen_boxInsideClip(
                             0, 0, a__screen.width, a__screen.height);
         APixel* dst = a__screen.pixels;
         APixel* src = Screen->pixels;
-        int r = 0, g = 0, b = 0;
         int alpha = a_pixel__state.alpha;
 
+        #if !A__PIXEL_SPANS
+            int r = 0, g = 0, b = 0;
+        #endif
+
         #define LOOP(Blend, Setup, Params)                                  \
             if(noClipping) {                                                \
                 for(int i = Screen->width * Screen->height; i--; ) {        \
@@ -332,6 +480,27 @@ void a_screen_blit(const AScreen* Screen)
                 }                                                           \
             }
 
+        #if A__PIXEL_SPANS
+            #define BLEND(Blend, Setup, Params)                                 \
+                if(noClipping) {                                                \
+                    a_pixel__span_##Blend##_data(                               \
+                        dst, src, Screen->width * Screen->height, alpha);       \
+                } else {                                                        \
+                    dst += a__screen.width * a__screen.clipY + a__screen.clipX; \
+                    src += a__screen.width * a__screen.clipY + a__screen.clipX; \
+                                                                                \
+                    for(int i = a__screen.clipHeight; i--; ) {                  \
+                        a_pixel__span_##Blend##_data(                           \
+                            dst, src, a__screen.clipWidth, alpha);              \
+                                                                                \
+                        dst += a__screen.width;                                 \
+                        src += a__screen.width;                                 \
+                    }                                                           \
+                }
+        #else
+            #define BLEND(Blend, Setup, Params) LOOP(Blend, Setup, Params)
+        #endif
+
         switch(a_pixel__state.blend) {
             case A_PIXEL_BLEND_PLAIN: {
                 if(noClipping) {
@@ -351,19 +520,23 @@ void a_screen_blit(const AScreen* Screen)
             } break;
 
             case A_PIXEL_BLEND_RGBA: {
-                LOOP(rgba, {a_pixel_toRgb(*src, &r, &g, &b);}, (dst, r, g, b, alpha));
+                if(alpha == 0) {
+                    break;
+                }
+
+                BLEND(rgba, {a_pixel_toRgb(*src, &r, &g, &b);}, (dst, r, g, b, alpha));
             } break;
 
             case A_PIXEL_BLEND_RGB25: {
-                LOOP(rgb25, {a_pixel_toRgb(*src, &r, &g, &b);}, (dst, r, g, b));
+                BLEND(rgb25, {a_pixel_toRgb(*src, &r, &g, &b);}, (dst, r, g, b));
             } break;
 
             case A_PIXEL_BLEND_RGB50: {
-                LOOP(rgb50, {a_pixel_toRgb(*src, &r, &g, &b);}, (dst, r, g, b));
+                BLEND(rgb50, {a_pixel_toRgb(*src, &r, &g, &b);}, (dst, r, g, b));
             } break;
 
             case A_PIXEL_BLEND_RGB75: {
-                LOOP(rgb75, {a_pixel_toRgb(*src, &r, &g, &b);}, (dst, r, g, b));
+                BLEND(rgb75, {a_pixel_toRgb(*src, &r, &g, &b);}, (dst, r, g, b));
             } break;
 
             case A_PIXEL_BLEND_INVERSE: {
@@ -371,7 +544,11 @@ void a_screen_blit(const AScreen* Screen)
             } break;
 
             case A_PIXEL_BLEND_MOD: {
-                LOOP(mod, {a_pixel_toRgb(*src, &r, &g, &b);}, (dst, r, g, b));
+                BLEND(mod, {a_pixel_toRgb(*src, &r, &g, &b);}, (dst, r, g, b));
+            } break;
+
+            case A_PIXEL_BLEND_ADD: {
+                BLEND(add, {a_pixel_toRgb(*src, &r, &g, &b);}, (dst, r, g, b));
             } break;
 
             default: break;
@@ -383,13 +560,24 @@ void a_screen_blit(const AScreen* Screen)
 
 void a_screen_clear(void)
 {
+    a_screen_clearColor(0);
+}
+
+void a_screen_clearColor(APixel Pixel)
+{
+    #if A__TILES
+        a_platform_software_tiles__flush();
+    #endif
+
+    a_screen__dirtyAll();
+
     #if A_CONFIG_LIB_RENDER_SOFTWARE
-        memset(a__screen.pixels, 0, a__screen.pixelsSize);
+        a_pixel__fill(a__screen.pixels, a__screen.width * a__screen.height, Pixel);
     #else
         a_pixel_push();
 
         a_pixel_blendSet(A_PIXEL_BLEND_PLAIN);
-        a_pixel_colorSetPixel(0);
+        a_pixel_colorSetPixel(Pixel);
         a_platform__renderClear();
 
         a_pixel_pop();
@@ -398,6 +586,10 @@ void a_screen_clear(void)
 
 static void pushTarget(APixel* Pixels, size_t PixelsSize, int Width, int Height, APlatformTexture* Texture, ASprite* Sprite)
 {
+    #if A__TILES
+        a_platform_software_tiles__flush();
+    #endif
+
     a_list_push(g_stack, a_mem_dup(&a__screen, sizeof(AScreen)));
 
     a__screen.pixels = Pixels;
@@ -408,6 +600,10 @@ static void pushTarget(APixel* Pixels, size_t PixelsSize, int Width, int Height,
     a__screen.height = Height;
     a__screen.ownsBuffer = false;
 
+    #if A__SCREEN_DIRTY
+        g_dirtyTrack = false;
+    #endif
+
     #if !A_CONFIG_LIB_RENDER_SOFTWARE
         a_platform__renderTargetSet(Texture);
     #endif
@@ -427,6 +623,11 @@ void a_screen_targetPushScreen(const AScreen* Screen)
 
 void a_screen_targetPushSprite(ASprite* Sprite)
 {
+    if(Sprite->indices) {
+        A__FATAL("a_screen_targetPushSprite(%s): Indexed sprite",
+                 A_SPRITE__NAME(Sprite));
+    }
+
     pushTarget(Sprite->pixels,
                Sprite->pixelsSize,
                Sprite->w,
@@ -437,11 +638,8 @@ void a_screen_targetPushSprite(ASprite* Sprite)
 
 void a_screen_targetPop(void)
 {
-    #if A_CONFIG_LIB_RENDER_SOFTWARE
-        if(a__screen.sprite) {
-            a__screen.sprite->texture = a_platform__textureNewSprite(
-                                            a__screen.sprite);
-        }
+    #if A__TILES
+        a_platform_software_tiles__flush();
     #endif
 
     AScreen* screen = a_list_pop(g_stack);
@@ -451,7 +649,11 @@ void a_screen_targetPop(void)
     }
 
     a__screen = *screen;
-    free(screen);
+    a_mem_free(screen);
+
+    #if A__SCREEN_DIRTY
+        g_dirtyTrack = a_list_isEmpty(g_stack);
+    #endif
 
     #if !A_CONFIG_LIB_RENDER_SOFTWARE
         a_platform__renderTargetSet(a__screen.texture);
@@ -37,6 +37,7 @@ extern void a_screen_free(AScreen* Screen);
 extern void a_screen_copy(AScreen* Dst, const AScreen* Src);
 extern void a_screen_blit(const AScreen* Screen);
 extern void a_screen_clear(void);
+extern void a_screen_clearColor(APixel Pixel);
 
 extern void a_screen_targetPushScreen(const AScreen* Screen);
 extern void a_screen_targetPushSprite(ASprite* Sprite);
@@ -38,7 +38,7 @@ struct AScreen {
     bool ownsBuffer;
 };
 
-extern AScreen a__screen;
+extern A__THREAD_LOCAL AScreen a__screen;
 
 extern void a_screen__init(void);
 extern void a_screen__uninit(void);
@@ -52,3 +52,34 @@ extern void a_screen__zoomSet(int Zoom);
 extern void a_screen_fullscreenFlip(void);
 
 extern bool a_screen__sameSize(const AScreen* Screen1, const AScreen* Screen2);
+
+#define A__SCREEN_DIRTY \
+    (A_CONFIG_LIB_RENDER_SOFTWARE && A_CONFIG_LIB_SDL && A_CONFIG_SCREEN_ALLOCATE)
+
+#if A__SCREEN_DIRTY
+    #define A__SCREEN_DIRTY_NUM 16
+
+    typedef struct {
+        int x, y, w, h;
+    } AScreenRect;
+
+    extern const AScreenRect* a_screen__dirtyGet(unsigned* Num);
+#endif
+
+#if A_CONFIG_LIB_RENDER_SOFTWARE
+    // Also marks the lines drawn on when the target is a sprite
+    extern void a_screen__dirtyAdd(int X, int Y, int Width, int Height);
+    extern void a_screen__dirtyAll(void);
+#else
+    static inline void a_screen__dirtyAdd(int X, int Y, int Width, int Height)
+    {
+        A_UNUSED(X);
+        A_UNUSED(Y);
+        A_UNUSED(Width);
+        A_UNUSED(Height);
+    }
+
+    static inline void a_screen__dirtyAll(void)
+    {
+    }
+#endif
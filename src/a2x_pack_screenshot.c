@@ -20,6 +20,7 @@
 
 #include "a2x_pack_dir.v.h"
 #include "a2x_pack_input_button.v.h"
+#include "a2x_pack_mem.v.h"
 #include "a2x_pack_out.v.h"
 #include "a2x_pack_png.v.h"
 #include "a2x_pack_screen.v.h"
@@ -59,7 +60,7 @@ static bool lazy_init(void)
                     g_isInit = true;
                 }
 
-                free(numberStr);
+                a_mem_free(numberStr);
             }
 
             if(!g_isInit) {
@@ -136,9 +137,9 @@ void a_screenshot__init(void)
 
 void a_screenshot__uninit(void)
 {
-    free(g_filePrefix);
-    free(g_title);
-    free(g_description);
+    a_mem_free(g_filePrefix);
+    a_mem_free(g_title);
+    a_mem_free(g_description);
 
     a_button_free(g_button);
 }
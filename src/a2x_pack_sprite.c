@@ -20,7 +20,10 @@
 
 #include "a2x_pack_main.v.h"
 #include "a2x_pack_mem.v.h"
+#include "a2x_pack_palette.v.h"
 #include "a2x_pack_pixel.v.h"
+#include "a2x_pack_platform_software_blit.v.h"
+#include "a2x_pack_platform_software_tiles.v.h"
 #include "a2x_pack_png.v.h"
 #include "a2x_pack_screen.v.h"
 #include "a2x_pack_str.v.h"
@@ -40,6 +43,9 @@ static ASprite* makeEmptySprite(int Width, int Height)
 
     s->pixels = NULL;
     s->pixelsSize = (unsigned)Width * (unsigned)Height * sizeof(APixel);
+    s->alpha = NULL;
+    s->indices = NULL;
+    s->palette = NULL;
     s->nameId = NULL;
     s->w = Width;
     s->wOriginal = Width;
@@ -52,12 +58,33 @@ static ASprite* makeEmptySprite(int Width, int Height)
 
 static void assignPixels(ASprite* Sprite, APixel* Pixels)
 {
-    free(Sprite->pixels);
+    a_mem_free(Sprite->pixels);
     Sprite->pixels = Pixels;
 
     Sprite->texture = a_platform__textureNewSprite(Sprite);
 }
 
+// Key out clear pixels, keep the alpha plane only if it has partial alpha
+static uint8_t* alphaFilter(APixel* Pixels, uint8_t* Alpha, int NumPixels)
+{
+    bool partial = false;
+
+    for(int i = NumPixels; i--; ) {
+        if(Alpha[i] == 0) {
+            Pixels[i] = a_sprite__colorKey;
+        } else if(Alpha[i] < 255) {
+            partial = true;
+        }
+    }
+
+    if(!partial) {
+        a_mem_free(Alpha);
+        Alpha = NULL;
+    }
+
+    return Alpha;
+}
+
 static int findNextVerticalEdge(const ASprite* Sheet, int StartX, int StartY, int* EdgeX)
 {
     for(int x = StartX + *EdgeX + 1; x < Sheet->w; x++) {
@@ -114,6 +141,11 @@ static int findNextHorizontalEdge(const ASprite* Sheet, int StartX, int StartY,
 
 void a_sprite__boundsFind(const ASprite* Sheet, int X, int Y, int* Width, int* Height)
 {
+    if(Sheet->indices) {
+        A__FATAL("a_sprite__boundsFind(%s): Indexed sprite",
+                 A_SPRITE__NAME(Sheet));
+    }
+
     if(X < 0 || X >= Sheet->w || Y < 0 || Y >= Sheet->h) {
         A__FATAL("a_sprite__boundsFind(%s, %d, %d): Invalid coords",
                  A_SPRITE__NAME(Sheet),
@@ -149,8 +181,13 @@ ASprite* a_sprite_newFromPng(const char* Path)
 {
     int w, h;
     APixel* pixels = NULL;
+    uint8_t* alpha = NULL;
 
-    a_png_readFile(Path, &pixels, &w, &h);
+    #if A_CONFIG_COLOR_SPRITE_ALPHA
+        a_png_readFileEx(Path, &pixels, &alpha, &w, &h);
+    #else
+        a_png_readFile(Path, &pixels, &w, &h);
+    #endif
 
     if(pixels == NULL) {
         A__FATAL("a_sprite_newFromPng(%s): Cannot read file", Path);
@@ -158,6 +195,10 @@ ASprite* a_sprite_newFromPng(const char* Path)
 
     ASprite* s = makeEmptySprite(w, h);
 
+    if(alpha) {
+        s->alpha = alphaFilter(pixels, alpha, w * h);
+    }
+
     assignPixels(s, pixels);
     s->nameId = a_str_dup(Path);
 
@@ -175,15 +216,42 @@ ASprite* a_sprite_newFromSprite(const ASprite* Sheet, int X, int Y)
 ASprite* a_sprite_newFromSpriteEx(const ASprite* Sheet, int X, int Y, int W, int H)
 {
     ASprite* sprite = makeEmptySprite(W, H);
-    APixel* pixels = a_mem_malloc(sprite->pixelsSize);
+    APixel* pixels = NULL;
+
+    if(Sheet->pixels) {
+        pixels = a_mem_malloc(sprite->pixelsSize);
+
+        const APixel* src = Sheet->pixels + Y * Sheet->w + X;
+        APixel* dst = pixels;
+
+        for(int i = H; i--; ) {
+            memcpy(dst, src, (unsigned)W * sizeof(APixel));
+            src += Sheet->w;
+            dst += W;
+        }
+    }
+
+    if(Sheet->indices) {
+        sprite->indices = a_mem_malloc((unsigned)W * (unsigned)H);
+        sprite->palette = a_palette_dup(Sheet->palette);
+
+        for(int i = 0; i < H; i++) {
+            memcpy(sprite->indices + i * W,
+                   Sheet->indices + (Y + i) * Sheet->w + X,
+                   (unsigned)W);
+        }
+    }
 
-    const APixel* src = Sheet->pixels + Y * Sheet->w + X;
-    APixel* dst = pixels;
+    if(Sheet->alpha) {
+        uint8_t* alpha = a_mem_malloc((unsigned)W * (unsigned)H);
+        const uint8_t* srcAlpha = Sheet->alpha + Y * Sheet->w + X;
 
-    for(int i = H; i--; ) {
-        memcpy(dst, src, (unsigned)W * sizeof(APixel));
-        src += Sheet->w;
-        dst += W;
+        for(int i = 0; i < H; i++) {
+            memcpy(alpha + i * W, srcAlpha, (unsigned)W);
+            srcAlpha += Sheet->w;
+        }
+
+        sprite->alpha = alphaFilter(pixels, alpha, W * H);
     }
 
     assignPixels(sprite, pixels);
@@ -212,22 +280,64 @@ ASprite* a_sprite_newBlank(int Width, int Height, bool ColorKeyed)
     return s;
 }
 
+ASprite* a_sprite_newIndexed(const ASprite* Sprite, const APalette* Palette)
+{
+    if(Sprite->indices || Sprite->alpha) {
+        A__FATAL("a_sprite_newIndexed(%s): Sprite is %s",
+                 A_SPRITE__NAME(Sprite),
+                 Sprite->indices ? "already indexed" : "translucent");
+    }
+
+    ASprite* s = makeEmptySprite(Sprite->w, Sprite->h);
+
+    s->palette = Palette
+                    ? a_palette_dup(Palette)
+                    : a_palette_newFromSprite(Sprite);
+    s->indices = a_palette__indicesNew(s->palette, Sprite);
+
+    #if A_CONFIG_LIB_RENDER_SOFTWARE
+        assignPixels(s, NULL);
+    #else
+        assignPixels(s, a_mem_dup(Sprite->pixels, Sprite->pixelsSize));
+    #endif
+
+    return s;
+}
+
 ASprite* a_sprite_dup(const ASprite* Sprite)
 {
     ASprite* clone = makeEmptySprite(Sprite->w, Sprite->h);
-    APixel* pixels = a_mem_dup(Sprite->pixels, Sprite->pixelsSize);
+    APixel* pixels = NULL;
+
+    if(Sprite->pixels) {
+        pixels = a_mem_dup(Sprite->pixels, Sprite->pixelsSize);
+    }
+
+    if(Sprite->alpha) {
+        clone->alpha = a_mem_dup(
+                        Sprite->alpha, Sprite->pixelsSize / sizeof(APixel));
+    }
+
+    if(Sprite->indices) {
+        clone->indices = a_mem_dup(
+                        Sprite->indices, Sprite->pixelsSize / sizeof(APixel));
+        clone->palette = a_palette_dup(Sprite->palette);
+    }
 
     assignPixels(clone, pixels);
 
     #if !A_CONFIG_LIB_RENDER_SOFTWARE
-        a_pixel_push();
-        a_screen_targetPushSprite(clone);
+        // Indexed sprites are never drawn on, so their pixels are current
+        if(clone->indices == NULL) {
+            a_pixel_push();
+            a_screen_targetPushSprite(clone);
 
-        a_pixel_reset();
-        a_sprite_blit(Sprite, 0, 0);
+            a_pixel_reset();
+            a_sprite_blit(Sprite, 0, 0);
 
-        a_screen_targetPop();
-        a_pixel_pop();
+            a_screen_targetPop();
+            a_pixel_pop();
+        }
     #endif
 
     return clone;
@@ -241,18 +351,40 @@ void a_sprite_free(ASprite* Sprite)
 
     a_platform__textureFree(Sprite->texture);
 
-    free(Sprite->nameId);
-    free(Sprite->pixels);
-    free(Sprite);
+    a_mem_free(Sprite->nameId);
+    a_mem_free(Sprite->pixels);
+    a_mem_free(Sprite->alpha);
+    a_mem_free(Sprite->indices);
+    a_mem_free(Sprite->palette);
+    a_mem_free(Sprite);
+}
+
+void a_sprite_atlasBegin(void)
+{
+    #if A_CONFIG_LIB_RENDER_SDL
+        a_platform__textureAtlasBegin();
+    #endif
+}
+
+void a_sprite_atlasEnd(void)
+{
+    #if A_CONFIG_LIB_RENDER_SDL
+        a_platform__textureAtlasEnd();
+    #endif
 }
 
 void a_sprite_blit(const ASprite* Sprite, int X, int Y)
 {
+    a_screen__dirtyAdd(X, Y, Sprite->w, Sprite->h);
+
     a_platform__textureBlit(Sprite->texture, X, Y, a_pixel__state.fillBlit);
 }
 
 void a_sprite_blitEx(const ASprite* Sprite, int X, int Y, AFix Scale, unsigned Angle, int CenterX, int CenterY)
 {
+    int r = a_sprite__blitExRadius(Sprite, Scale, CenterX, CenterY);
+    a_screen__dirtyAdd(X - r, Y - r, 2 * r, 2 * r);
+
     a_platform__textureBlitEx(Sprite->texture,
                               X,
                               Y,
@@ -263,31 +395,93 @@ void a_sprite_blitEx(const ASprite* Sprite, int X, int Y, AFix Scale, unsigned A
                               a_pixel__state.fillBlit);
 }
 
+// Spans only depend on which pixels have the color key
+static void swappedLines(ASprite* Sprite, int Y, int Y2, bool KeyChanged)
+{
+    #if A_CONFIG_LIB_RENDER_SOFTWARE
+        if(KeyChanged) {
+            a_platform_software_blit__textureDirty(Sprite->texture, Y, Y2);
+        }
+    #else
+        A_UNUSED(Y);
+        A_UNUSED(Y2);
+        A_UNUSED(KeyChanged);
+
+        Sprite->texture = a_platform__textureNewSprite(Sprite);
+    #endif
+}
+
 void a_sprite_swapColor(ASprite* Sprite, APixel OldColor, APixel NewColor)
 {
-    for(size_t i = Sprite->pixelsSize / sizeof(APixel); i--; ) {
-        if(Sprite->pixels[i] == OldColor) {
-            Sprite->pixels[i] = NewColor;
+    if(Sprite->indices) {
+        A__FATAL("a_sprite_swapColor(%s): Indexed sprite",
+                 A_SPRITE__NAME(Sprite));
+    }
+
+    #if A__TILES
+        a_platform_software_tiles__flush();
+    #endif
+
+    APixel* pixels = Sprite->pixels;
+    int y = Sprite->h, y2 = 0;
+
+    for(int i = 0; i < Sprite->h; i++) {
+        for(int j = Sprite->w; j--; pixels++) {
+            if(*pixels == OldColor) {
+                *pixels = NewColor;
+                y = a_math_min(y, i);
+                y2 = i + 1;
+            }
         }
     }
 
-    Sprite->texture = a_platform__textureNewSprite(Sprite);
+    swappedLines(Sprite,
+                 y,
+                 y2,
+                 OldColor == a_sprite__colorKey
+                    || NewColor == a_sprite__colorKey);
 }
 
 void a_sprite_swapColors(ASprite* Sprite, const APixel* OldColors, const APixel* NewColors, unsigned NumColors)
 {
-    for(size_t i = Sprite->pixelsSize / sizeof(APixel); i--; ) {
-        const APixel pixel = Sprite->pixels[i];
+    if(Sprite->indices) {
+        A__FATAL("a_sprite_swapColors(%s): Indexed sprite",
+                 A_SPRITE__NAME(Sprite));
+    }
+
+    #if A__TILES
+        a_platform_software_tiles__flush();
+    #endif
+
+    APixel* pixels = Sprite->pixels;
+    int y = Sprite->h, y2 = 0;
+    bool keyChanged = false;
+
+    for(unsigned c = NumColors; c--; ) {
+        if(OldColors[c] == a_sprite__colorKey
+            || NewColors[c] == a_sprite__colorKey) {
 
-        for(unsigned c = NumColors; c--; ) {
-            if(pixel == OldColors[c]) {
-                Sprite->pixels[i] = NewColors[c];
-                break;
+            keyChanged = true;
+            break;
+        }
+    }
+
+    for(int i = 0; i < Sprite->h; i++) {
+        for(int j = Sprite->w; j--; pixels++) {
+            const APixel pixel = *pixels;
+
+            for(unsigned c = NumColors; c--; ) {
+                if(pixel == OldColors[c]) {
+                    *pixels = NewColors[c];
+                    y = a_math_min(y, i);
+                    y2 = i + 1;
+                    break;
+                }
             }
         }
     }
 
-    Sprite->texture = a_platform__textureNewSprite(Sprite);
+    swappedLines(Sprite, y, y2, keyChanged);
 }
 
 AVectorInt a_sprite_sizeGet(const ASprite* Sprite)
@@ -321,6 +515,15 @@ void a_sprite_sizeSetWidthPow2(ASprite* Sprite)
         return;
     }
 
+    if(Sprite->indices) {
+        A__FATAL("a_sprite_sizeSetWidthPow2(%s): Indexed sprite",
+                 A_SPRITE__NAME(Sprite));
+    }
+
+    #if A__TILES
+        a_platform_software_tiles__flush();
+    #endif
+
     int power = 1;
 
     while((1 << power) < Sprite->w) {
@@ -352,6 +555,19 @@ void a_sprite_sizeSetWidthPow2(ASprite* Sprite)
         }
     }
 
+    if(Sprite->alpha) {
+        uint8_t* newAlpha = a_mem_zalloc(newSize / sizeof(APixel));
+
+        for(int i = 0; i < Sprite->h; i++) {
+            memcpy(newAlpha + i * newWidth + leftPadding,
+                   Sprite->alpha + i * oldWidth,
+                   (unsigned)oldWidth);
+        }
+
+        a_mem_free(Sprite->alpha);
+        Sprite->alpha = newAlpha;
+    }
+
     Sprite->w = newWidth;
     Sprite->wLog2 = power;
     Sprite->pixelsSize = newSize;
@@ -361,14 +577,28 @@ void a_sprite_sizeSetWidthPow2(ASprite* Sprite)
 
 const APixel* a_sprite_pixelsGetBuffer(const ASprite* Sprite)
 {
+    if(Sprite->indices) {
+        A__FATAL("a_sprite_pixelsGetBuffer(%s): Indexed sprite",
+                 A_SPRITE__NAME(Sprite));
+    }
+
     return Sprite->pixels;
 }
 
 APixel a_sprite_pixelsGetPixel(const ASprite* Sprite, int X, int Y)
 {
+    if(Sprite->indices) {
+        return Sprite->palette->colors[Sprite->indices[Y * Sprite->w + X]];
+    }
+
     return *(Sprite->pixels + Y * Sprite->w + X);
 }
 
+const APalette* a_sprite_paletteGet(const ASprite* Sprite)
+{
+    return Sprite->palette;
+}
+
 APixel a_sprite_colorKeyGet(void)
 {
     return a_sprite__colorKey;
@@ -23,15 +23,20 @@
 typedef struct ASprite ASprite;
 
 #include "a2x_pack_fix.p.h"
+#include "a2x_pack_palette.p.h"
 #include "a2x_pack_pixel.p.h"
 
 extern ASprite* a_sprite_newFromPng(const char* Path);
 extern ASprite* a_sprite_newFromSprite(const ASprite* Sheet, int X, int Y);
 extern ASprite* a_sprite_newFromSpriteEx(const ASprite* Sheet, int X, int Y, int W, int H);
 extern ASprite* a_sprite_newBlank(int Width, int Height, bool ColorKeyed);
+extern ASprite* a_sprite_newIndexed(const ASprite* Sprite, const APalette* Palette);
 extern ASprite* a_sprite_dup(const ASprite* Sprite);
 extern void a_sprite_free(ASprite* Sprite);
 
+extern void a_sprite_atlasBegin(void);
+extern void a_sprite_atlasEnd(void);
+
 extern void a_sprite_blit(const ASprite* Sprite, int X, int Y);
 extern void a_sprite_blitEx(const ASprite* Sprite, int X, int Y, AFix Scale, unsigned Angle, int CenterX, int CenterY);
 
@@ -48,4 +53,6 @@ extern void a_sprite_sizeSetWidthPow2(ASprite* Sprite);
 extern const APixel* a_sprite_pixelsGetBuffer(const ASprite* Sprite);
 extern APixel a_sprite_pixelsGetPixel(const ASprite* Sprite, int X, int Y);
 
+extern const APalette* a_sprite_paletteGet(const ASprite* Sprite);
+
 extern APixel a_sprite_colorKeyGet(void);
@@ -20,11 +20,15 @@
 
 #include "a2x_pack_sprite.p.h"
 
+#include "a2x_pack_math.v.h"
 #include "a2x_pack_platform.v.h"
 
 struct ASprite {
     APixel* pixels;
     size_t pixelsSize;
+    uint8_t* alpha; // per-pixel alpha plane if the sprite has partial alpha
+    uint8_t* indices; // palette indices if the sprite is indexed, 0 is clear
+    APalette* palette;
     char* nameId;
     int w, wOriginal, wLog2, h;
     APlatformTexture* texture;
@@ -40,3 +44,16 @@ extern void a_sprite__boundsFind(const ASprite* Sheet, int X, int Y, int* Width,
 
 #define A_SPRITE__NAME(Sprite) (Sprite->nameId ? Sprite->nameId : "Sprite")
 #define a_sprite__pixelsGetPixel(s, x, y) (*((s)->pixels + (y) * (s)->w + (x)))
+
+// Distance from the blit point that a scaled and rotated sprite stays within
+static inline int a_sprite__blitExRadius(const ASprite* Sprite, AFix Scale, int CenterX, int CenterY)
+{
+    const int pivotX = Sprite->w / 2 + CenterX;
+    const int pivotY = Sprite->h / 2 + CenterY;
+
+    int64_t r = (int64_t)(a_math_max(pivotX, Sprite->w - pivotX)
+                            + a_math_max(pivotY, Sprite->h - pivotY))
+                    * Scale / A_FIX_ONE + 2;
+
+    return r < (1 << 28) ? (int)r : 1 << 28;
+}
@@ -57,7 +57,7 @@ ASpriteFrames* a_spriteframes_newFromPng(const char* Path, int CellWidth, int Ce
                 CellHeight = 0;
             }
 
-            free(suffix);
+            a_mem_free(suffix);
         }
     }
 
@@ -90,6 +90,8 @@ ASpriteFrames* a_spriteframes_newFromSpriteEx(const ASprite* Sheet, int X, int Y
     int endX = X + GridWidth - (GridWidth % CellWidth);
     int endY = Y + GridHeight - (GridHeight % CellHeight);
 
+    a_sprite_atlasBegin();
+
     for(int y = Y; y < endY; y += CellHeight) {
         for(int x = X; x < endX; x += CellWidth) {
             ASprite* s = a_sprite_newFromSpriteEx(
@@ -99,6 +101,8 @@ ASpriteFrames* a_spriteframes_newFromSpriteEx(const ASprite* Sheet, int X, int Y
         }
     }
 
+    a_sprite_atlasEnd();
+
     f->spriteArray = (ASprite**)a_list_toArray(f->sprites);
     f->num = a_list_sizeGet(f->sprites);
 
@@ -149,8 +153,8 @@ void a_spriteframes_free(ASpriteFrames* Frames, bool FreeSprites)
         a_list_free(Frames->sprites);
     }
 
-    free(Frames->spriteArray);
-    free(Frames);
+    a_mem_free(Frames->spriteArray);
+    a_mem_free(Frames);
 }
 
 void a_spriteframes_clear(ASpriteFrames* Frames, bool FreeSprites)
@@ -184,7 +188,7 @@ static void addedSprite(ASpriteFrames* Frames)
 {
     Frames->num++;
 
-    free(Frames->spriteArray);
+    a_mem_free(Frames->spriteArray);
     Frames->spriteArray = (ASprite**)a_list_toArray(Frames->sprites);
 
     a_spriteframes_reset(Frames);
@@ -208,7 +212,7 @@ static void removedSprite(ASpriteFrames* Frames)
 {
     Frames->num--;
 
-    free(Frames->spriteArray);
+    a_mem_free(Frames->spriteArray);
     Frames->spriteArray = (ASprite**)a_list_toArray(Frames->sprites);
 
     a_spriteframes_reset(Frames);
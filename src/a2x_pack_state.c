@@ -82,7 +82,7 @@ static void pending_handle(void)
     if(current && current->stage == A__STATE_STAGE_FREE) {
         a_out__stateV("Destroying '%s' instance", current->state->name);
 
-        free(a_list_pop(g_stack));
+        a_mem_free(a_list_pop(g_stack));
         current = a_list_peek(g_stack);
 
         if(!g_exiting && a_list_isEmpty(g_pending)
@@ -145,10 +145,10 @@ void a_state__init(void)
 
 void a_state__uninit(void)
 {
-    free(g_table);
+    a_mem_free(g_table);
 
-    a_list_freeEx(g_stack, free);
-    a_list_freeEx(g_pending, free);
+    a_list_freeEx(g_stack, a_mem_free);
+    a_list_freeEx(g_pending, a_mem_free);
 }
 
 void a_state_init(unsigned NumStates)
@@ -273,7 +273,7 @@ void a_state_exit(void)
     g_exiting = true;
 
     // Clear the pending actions queue
-    a_list_clearEx(g_pending, free);
+    a_list_clearEx(g_pending, a_mem_free);
 
     // Queue a pop for every state in the stack
     for(unsigned i = a_list_sizeGet(g_stack); i--; ) {
@@ -338,6 +338,10 @@ static bool iteration(void)
         a_screen__draw();
 
         a_fps__frame();
+
+        #if A_CONFIG_BUILD_DEBUG_MEM
+            a_mem__frame();
+        #endif
     } else {
         a_out__stateV(
             "  '%s' running %s", s->state->name, g_stageNames[s->stage]);
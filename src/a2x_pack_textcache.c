@@ -0,0 +1,193 @@
+/*
+    Copyright 2019 Alex Margarit <alex@alxm.org>
+    This file is part of a2x, a C video game framework.
+
+    This program is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    This program is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with this program.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#include "a2x_pack_textcache.v.h"
+
+#include "a2x_pack_font.v.h"
+#include "a2x_pack_math.v.h"
+#include "a2x_pack_mem.v.h"
+#include "a2x_pack_pixel.v.h"
+#include "a2x_pack_screen.v.h"
+#include "a2x_pack_sprite.v.h"
+#include "a2x_pack_str.v.h"
+
+typedef struct {
+    const ASprite* sprite;
+    int x, y;
+} ATextCacheGlyph;
+
+struct ATextCache {
+    char* text;
+    AFontLayout layout; // font state the text was laid out with
+    ATextCacheGlyph* glyphs;
+    unsigned num, capacity;
+    int x, y, w, h; // bounding box, relative to the draw coords
+    ASprite* sprite; // all glyphs drawn once, made on first use
+};
+
+static char g_buffer[512];
+
+ATextCache* a_textcache_new(void)
+{
+    return a_mem_zalloc(sizeof(ATextCache));
+}
+
+void a_textcache_free(ATextCache* Cache)
+{
+    if(Cache == NULL) {
+        return;
+    }
+
+    a_sprite_free(Cache->sprite);
+
+    a_mem_free(Cache->glyphs);
+    a_mem_free(Cache->text);
+    a_mem_free(Cache);
+}
+
+static void glyphAdd(const ASprite* Glyph, int X, int Y, void* Context)
+{
+    ATextCache* cache = Context;
+
+    if(cache->num == cache->capacity) {
+        unsigned capacity = cache->capacity < 16 ? 16 : cache->capacity * 2;
+        ATextCacheGlyph* glyphs =
+            a_mem_malloc(capacity * sizeof(ATextCacheGlyph));
+
+        if(cache->glyphs) {
+            memcpy(glyphs,
+                   cache->glyphs,
+                   cache->capacity * sizeof(ATextCacheGlyph));
+
+            a_mem_free(cache->glyphs);
+        }
+
+        cache->glyphs = glyphs;
+        cache->capacity = capacity;
+    }
+
+    cache->glyphs[cache->num++] = (ATextCacheGlyph){Glyph, X, Y};
+}
+
+static bool layoutEqual(const AFontLayout* A, const AFontLayout* B)
+{
+    return A->font == B->font
+        && A->align == B->align
+        && A->lineHeight == B->lineHeight
+        && A->wrapWidth == B->wrapWidth;
+}
+
+void a_textcache_textSet(ATextCache* Cache, const char* Text)
+{
+    AFontLayout layout;
+    a_font__layoutGet(&layout);
+
+    if(Cache->text
+        && a_str_equal(Cache->text, Text)
+        && layoutEqual(&Cache->layout, &layout)) {
+
+        return;
+    }
+
+    a_mem_free(Cache->text);
+    Cache->text = a_str_dup(Text);
+    Cache->layout = layout;
+    Cache->num = 0;
+
+    a_sprite_free(Cache->sprite);
+    Cache->sprite = NULL;
+
+    a_font_push();
+    a_font_coordsSet(0, 0);
+    a_font__printEx(Text, glyphAdd, Cache);
+    a_font_pop();
+
+    int x1 = INT_MAX, y1 = INT_MAX;
+    int x2 = INT_MIN, y2 = INT_MIN;
+
+    for(unsigned g = 0; g < Cache->num; g++) {
+        const ATextCacheGlyph* glyph = &Cache->glyphs[g];
+
+        x1 = a_math_min(x1, glyph->x);
+        y1 = a_math_min(y1, glyph->y);
+        x2 = a_math_max(x2, glyph->x + a_sprite_sizeGetWidth(glyph->sprite));
+        y2 = a_math_max(y2, glyph->y + a_sprite_sizeGetHeight(glyph->sprite));
+    }
+
+    if(Cache->num == 0) {
+        x1 = y1 = x2 = y2 = 0;
+    }
+
+    Cache->x = x1;
+    Cache->y = y1;
+    Cache->w = x2 - x1;
+    Cache->h = y2 - y1;
+}
+
+void a_textcache_textSetf(ATextCache* Cache, const char* Format, ...)
+{
+    va_list args;
+    va_start(args, Format);
+
+    a_textcache_textSetv(Cache, Format, args);
+
+    va_end(args);
+}
+
+void a_textcache_textSetv(ATextCache* Cache, const char* Format, va_list Args)
+{
+    if(a_str_fmtv(g_buffer, sizeof(g_buffer), true, Format, Args)) {
+        a_textcache_textSet(Cache, g_buffer);
+    }
+}
+
+AVectorInt a_textcache_sizeGet(const ATextCache* Cache)
+{
+    return (AVectorInt){Cache->w, Cache->h};
+}
+
+void a_textcache_draw(const ATextCache* Cache, int X, int Y)
+{
+    for(unsigned g = 0; g < Cache->num; g++) {
+        const ATextCacheGlyph* glyph = &Cache->glyphs[g];
+
+        a_sprite_blit(glyph->sprite, X + glyph->x, Y + glyph->y);
+    }
+}
+
+void a_textcache_drawSprite(ATextCache* Cache, int X, int Y)
+{
+    if(Cache->w <= 0 || Cache->h <= 0) {
+        return;
+    }
+
+    if(Cache->sprite == NULL) {
+        Cache->sprite = a_sprite_newBlank(Cache->w, Cache->h, true);
+
+        a_pixel_push();
+        a_pixel_reset();
+        a_screen_targetPushSprite(Cache->sprite);
+
+        a_textcache_draw(Cache, -Cache->x, -Cache->y);
+
+        a_screen_targetPop();
+        a_pixel_pop();
+    }
+
+    a_sprite_blit(Cache->sprite, X + Cache->x, Y + Cache->y);
+}
@@ -0,0 +1,38 @@
+/*
+    Copyright 2019 Alex Margarit <alex@alxm.org>
+    This file is part of a2x, a C video game framework.
+
+    This program is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    This program is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with this program.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#pragma once
+
+#include "a2x_system_includes.h"
+
+typedef struct ATextCache ATextCache;
+
+#include "a2x_pack_fix.p.h"
+
+// Caches point to their font's glyph sprites, so must not outlive the font
+extern ATextCache* a_textcache_new(void);
+extern void a_textcache_free(ATextCache* Cache);
+
+extern void a_textcache_textSet(ATextCache* Cache, const char* Text);
+extern void a_textcache_textSetf(ATextCache* Cache, const char* Format, ...);
+extern void a_textcache_textSetv(ATextCache* Cache, const char* Format, va_list Args);
+
+extern AVectorInt a_textcache_sizeGet(const ATextCache* Cache);
+
+extern void a_textcache_draw(const ATextCache* Cache, int X, int Y);
+extern void a_textcache_drawSprite(ATextCache* Cache, int X, int Y);
@@ -0,0 +1,427 @@
+/*
+    Copyright 2019 Alex Margarit <alex@alxm.org>
+    This file is part of a2x, a C video game framework.
+
+    This program is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    This program is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with this program.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#include "a2x_pack_tilemap.v.h"
+
+#include "a2x_pack_listit.v.h"
+#include "a2x_pack_main.v.h"
+#include "a2x_pack_math.v.h"
+#include "a2x_pack_mem.v.h"
+#include "a2x_pack_pixel_simd.v.h"
+#include "a2x_pack_platform_software_blit.v.h"
+#include "a2x_pack_platform_software_tiles.v.h"
+#include "a2x_pack_screen.v.h"
+#include "a2x_pack_sprite.v.h"
+#include "a2x_pack_spriteframes.v.h"
+
+// The software renderer keeps static layers pre-drawn in a ring of tiles
+// around the view, GPU renderers draw every visible tile
+#define A__TILEMAP_CACHE A_CONFIG_LIB_RENDER_SOFTWARE
+
+struct ATilemap {
+    int w, h; // in tiles
+    int tileW, tileH;
+    int* map; // w * h tile indices, or A_TILEMAP_NONE
+    ASprite** tiles;
+    unsigned numTiles;
+    bool isStatic;
+    #if A__TILEMAP_CACHE
+        ASprite* cache; // cacheCols * cacheRows tiles, wraps around
+        int cacheCols, cacheRows;
+        int cacheX, cacheY; // first tile column and row held in the cache
+        bool* cacheDirty; // per cache cell
+        bool cacheStale;
+        bool hasIndexed; // indexed tiles are drawn over the cache
+    #endif
+};
+
+static int divFloor(int X, int Y)
+{
+    return X >= 0 ? X / Y : -((-X + Y - 1) / Y);
+}
+
+ATilemap* a_tilemap_new(const ASpriteFrames* Tiles, int Width, int Height, bool Static)
+{
+    unsigned numTiles = a_spriteframes_framesNumGet(Tiles);
+
+    if(numTiles == 0 || Width <= 0 || Height <= 0) {
+        A__FATAL("a_tilemap_new(%u, %d, %d): Invalid size",
+                 numTiles,
+                 Width,
+                 Height);
+    }
+
+    ATilemap* t = a_mem_zalloc(sizeof(ATilemap));
+
+    t->w = Width;
+    t->h = Height;
+    t->map = a_mem_malloc((size_t)(Width * Height) * sizeof(int));
+    t->tiles = a_mem_malloc(numTiles * sizeof(ASprite*));
+    t->numTiles = numTiles;
+    t->isStatic = Static;
+
+    for(int i = Width * Height; i--; ) {
+        t->map[i] = A_TILEMAP_NONE;
+    }
+
+    A_LIST_ITERATE(a_spriteframes_framesListGet(Tiles), ASprite*, s) {
+        if(A_LIST_INDEX() == 0) {
+            t->tileW = s->w;
+            t->tileH = s->h;
+        } else if(s->w != t->tileW || s->h != t->tileH) {
+            A__FATAL("a_tilemap_new: Tile %u is %dx%d, expected %dx%d",
+                     A_LIST_INDEX(),
+                     s->w,
+                     s->h,
+                     t->tileW,
+                     t->tileH);
+        }
+
+        t->tiles[A_LIST_INDEX()] = s;
+
+        #if A__TILEMAP_CACHE
+            if(s->indices) {
+                t->hasIndexed = true;
+            }
+        #endif
+    }
+
+    return t;
+}
+
+void a_tilemap_free(ATilemap* Tilemap)
+{
+    if(Tilemap == NULL) {
+        return;
+    }
+
+    #if A__TILEMAP_CACHE
+        #if A__TILES
+            a_platform_software_tiles__flush();
+        #endif
+
+        a_sprite_free(Tilemap->cache);
+        a_mem_free(Tilemap->cacheDirty);
+    #endif
+
+    a_mem_free(Tilemap->map);
+    a_mem_free(Tilemap->tiles);
+    a_mem_free(Tilemap);
+}
+
+AVectorInt a_tilemap_sizeGet(const ATilemap* Tilemap)
+{
+    return (AVectorInt){Tilemap->w, Tilemap->h};
+}
+
+AVectorInt a_tilemap_tileSizeGet(const ATilemap* Tilemap)
+{
+    return (AVectorInt){Tilemap->tileW, Tilemap->tileH};
+}
+
+int a_tilemap_tileGet(const ATilemap* Tilemap, int X, int Y)
+{
+    if(X < 0 || X >= Tilemap->w || Y < 0 || Y >= Tilemap->h) {
+        A__FATAL("a_tilemap_tileGet(%d, %d): Invalid coords", X, Y);
+    }
+
+    return Tilemap->map[Y * Tilemap->w + X];
+}
+
+void a_tilemap_tileSet(ATilemap* Tilemap, int X, int Y, int Tile)
+{
+    if(X < 0 || X >= Tilemap->w || Y < 0 || Y >= Tilemap->h) {
+        A__FATAL("a_tilemap_tileSet(%d, %d): Invalid coords", X, Y);
+    }
+
+    if(Tile != A_TILEMAP_NONE
+        && (Tile < 0 || (unsigned)Tile >= Tilemap->numTiles)) {
+
+        A__FATAL("a_tilemap_tileSet(%d, %d, %d): Invalid tile", X, Y, Tile);
+    }
+
+    Tilemap->map[Y * Tilemap->w + X] = Tile;
+
+    #if A__TILEMAP_CACHE
+        if(Tilemap->cache
+            && X >= Tilemap->cacheX && X < Tilemap->cacheX + Tilemap->cacheCols
+            && Y >= Tilemap->cacheY && Y < Tilemap->cacheY + Tilemap->cacheRows) {
+
+            Tilemap->cacheDirty[(Y % Tilemap->cacheRows) * Tilemap->cacheCols
+                                    + X % Tilemap->cacheCols] = true;
+            Tilemap->cacheStale = true;
+        }
+    #endif
+}
+
+#if A__TILEMAP_CACHE
+static void cacheNew(ATilemap* Tilemap, int TileX, int TileY)
+{
+    #if A__TILES
+        a_platform_software_tiles__flush();
+    #endif
+
+    a_sprite_free(Tilemap->cache);
+    a_mem_free(Tilemap->cacheDirty);
+
+    // Enough tiles for any view up to the screen size at any scroll offset
+    const int cols = a__screen.width / Tilemap->tileW + 2;
+    const int rows = a__screen.height / Tilemap->tileH + 2;
+
+    Tilemap->cache = a_sprite_newBlank(
+                        cols * Tilemap->tileW, rows * Tilemap->tileH, true);
+    Tilemap->cacheCols = cols;
+    Tilemap->cacheRows = rows;
+    Tilemap->cacheX = TileX;
+    Tilemap->cacheY = TileY;
+    Tilemap->cacheDirty = a_mem_malloc((size_t)(cols * rows) * sizeof(bool));
+    Tilemap->cacheStale = true;
+
+    for(int i = cols * rows; i--; ) {
+        Tilemap->cacheDirty[i] = true;
+    }
+
+    for(unsigned t = 0; t < Tilemap->numTiles; t++) {
+        if(Tilemap->tiles[t]->alpha) {
+            Tilemap->cache->alpha = a_mem_zalloc(
+                                        (size_t)(Tilemap->cache->w
+                                                    * Tilemap->cache->h));
+            Tilemap->cache->texture =
+                a_platform__textureNewSprite(Tilemap->cache);
+            break;
+        }
+    }
+}
+
+static void cacheCellRender(ATilemap* Tilemap, int TileX, int TileY)
+{
+    ASprite* cache = Tilemap->cache;
+    const int offset = (TileY % Tilemap->cacheRows) * Tilemap->tileH * cache->w
+                        + (TileX % Tilemap->cacheCols) * Tilemap->tileW;
+    const size_t rowSize = (size_t)Tilemap->tileW;
+    APixel* dst = cache->pixels + offset;
+    uint8_t* dstAlpha = cache->alpha ? cache->alpha + offset : NULL;
+    int tile = A_TILEMAP_NONE;
+
+    if(TileX < Tilemap->w && TileY < Tilemap->h) {
+        tile = Tilemap->map[TileY * Tilemap->w + TileX];
+    }
+
+    // Indexed tiles follow the current palette, so they are not cached
+    if(tile == A_TILEMAP_NONE || Tilemap->tiles[tile]->indices) {
+        for(int y = Tilemap->tileH; y--; dst += cache->w) {
+            a_pixel__fill(dst, Tilemap->tileW, a_sprite__colorKey);
+
+            if(dstAlpha) {
+                memset(dstAlpha, 0, rowSize);
+                dstAlpha += cache->w;
+            }
+        }
+
+        return;
+    }
+
+    const ASprite* s = Tilemap->tiles[tile];
+    const APixel* src = s->pixels;
+    const uint8_t* srcAlpha = s->alpha;
+
+    for(int y = Tilemap->tileH; y--; dst += cache->w, src += s->w) {
+        memcpy(dst, src, rowSize * sizeof(APixel));
+
+        if(dstAlpha) {
+            if(srcAlpha) {
+                memcpy(dstAlpha, srcAlpha, rowSize);
+                srcAlpha += s->w;
+            } else {
+                memset(dstAlpha, 255, rowSize);
+            }
+
+            dstAlpha += cache->w;
+        }
+    }
+}
+
+static void cacheUpdate(ATilemap* Tilemap, int TileX, int TileY, int TileX2, int TileY2)
+{
+    if(Tilemap->cache == NULL
+        || TileX2 - TileX > Tilemap->cacheCols
+        || TileY2 - TileY > Tilemap->cacheRows) {
+
+        cacheNew(Tilemap, TileX, TileY);
+    }
+
+    // Scroll the cached area just enough to hold the view
+    const int cols = Tilemap->cacheCols;
+    const int rows = Tilemap->cacheRows;
+    int x = Tilemap->cacheX;
+    int y = Tilemap->cacheY;
+
+    if(TileX < x) {
+        x = TileX;
+    } else if(TileX2 > x + cols) {
+        x = a_math_max(TileX2 - cols, 0);
+    }
+
+    if(TileY < y) {
+        y = TileY;
+    } else if(TileY2 > y + rows) {
+        y = a_math_max(TileY2 - rows, 0);
+    }
+
+    if(x != Tilemap->cacheX || y != Tilemap->cacheY) {
+        // Cells keep their place in the ring, only newly exposed ones change
+        for(int ty = y; ty < y + rows; ty++) {
+            for(int tx = x; tx < x + cols; tx++) {
+                if(tx < Tilemap->cacheX || tx >= Tilemap->cacheX + cols
+                    || ty < Tilemap->cacheY || ty >= Tilemap->cacheY + rows) {
+
+                    Tilemap->cacheDirty[(ty % rows) * cols + tx % cols] = true;
+                }
+            }
+        }
+
+        Tilemap->cacheX = x;
+        Tilemap->cacheY = y;
+        Tilemap->cacheStale = true;
+    }
+
+    if(!Tilemap->cacheStale) {
+        return;
+    }
+
+    #if A__TILES
+        // Queued blits may still read the cache's current spans
+        a_platform_software_tiles__flush();
+    #endif
+
+    for(int ty = y; ty < y + rows; ty++) {
+        for(int tx = x; tx < x + cols; tx++) {
+            bool* dirty = &Tilemap->cacheDirty[(ty % rows) * cols + tx % cols];
+
+            if(*dirty) {
+                const int cacheY = (ty % rows) * Tilemap->tileH;
+
+                cacheCellRender(Tilemap, tx, ty);
+                a_platform_software_blit__textureDirty(
+                    Tilemap->cache->texture, cacheY, cacheY + Tilemap->tileH);
+
+                *dirty = false;
+            }
+        }
+    }
+
+    Tilemap->cacheStale = false;
+}
+
+static void cacheDraw(const ATilemap* Tilemap, int X, int Y, int TileX, int TileY, int TileX2, int TileY2)
+{
+    const int clipX = a__screen.clipX;
+    const int clipY = a__screen.clipY;
+    const int clipW = a__screen.clipWidth;
+    const int clipH = a__screen.clipHeight;
+
+    const int areaX[2] = {a_math_max(clipX, X + TileX * Tilemap->tileW),
+                          a_math_min(clipX + clipW,
+                                     X + TileX2 * Tilemap->tileW)};
+    const int areaY[2] = {a_math_max(clipY, Y + TileY * Tilemap->tileH),
+                          a_math_min(clipY + clipH,
+                                     Y + TileY2 * Tilemap->tileH)};
+
+    // The ring wraps once each way, so the view is up to 4 pieces of it
+    const int ringX = X + (Tilemap->cacheX - Tilemap->cacheX
+                                                % Tilemap->cacheCols)
+                            * Tilemap->tileW;
+    const int ringY = Y + (Tilemap->cacheY - Tilemap->cacheY
+                                                % Tilemap->cacheRows)
+                            * Tilemap->tileH;
+    const int wrapX = ringX + Tilemap->cache->w;
+    const int wrapY = ringY + Tilemap->cache->h;
+
+    const int pieceX[2][2] = {{areaX[0], a_math_min(areaX[1], wrapX)},
+                              {a_math_max(areaX[0], wrapX), areaX[1]}};
+    const int pieceY[2][2] = {{areaY[0], a_math_min(areaY[1], wrapY)},
+                              {a_math_max(areaY[0], wrapY), areaY[1]}};
+
+    for(int py = 0; py < 2; py++) {
+        for(int px = 0; px < 2; px++) {
+            const int w = pieceX[px][1] - pieceX[px][0];
+            const int h = pieceY[py][1] - pieceY[py][0];
+
+            if(w <= 0 || h <= 0) {
+                continue;
+            }
+
+            a_screen_clipSet(pieceX[px][0], pieceY[py][0], w, h);
+
+            a_sprite_blit(Tilemap->cache,
+                          px ? wrapX : ringX,
+                          py ? wrapY : ringY);
+        }
+    }
+
+    a_screen_clipSet(clipX, clipY, clipW, clipH);
+}
+#endif
+
+void a_tilemap_draw(ATilemap* Tilemap, int X, int Y)
+{
+    // Tiles that overlap the clip area
+    const int tileX = a_math_max(
+                        divFloor(a__screen.clipX - X, Tilemap->tileW), 0);
+    const int tileY = a_math_max(
+                        divFloor(a__screen.clipY - Y, Tilemap->tileH), 0);
+    const int tileX2 = a_math_min(
+                        -divFloor(X - a__screen.clipX2, Tilemap->tileW),
+                        Tilemap->w);
+    const int tileY2 = a_math_min(
+                        -divFloor(Y - a__screen.clipY2, Tilemap->tileH),
+                        Tilemap->h);
+
+    if(tileX >= tileX2 || tileY >= tileY2) {
+        return;
+    }
+
+    bool cached = false;
+
+    #if A__TILEMAP_CACHE
+        if(Tilemap->isStatic) {
+            cacheUpdate(Tilemap, tileX, tileY, tileX2, tileY2);
+            cacheDraw(Tilemap, X, Y, tileX, tileY, tileX2, tileY2);
+
+            if(!Tilemap->hasIndexed) {
+                return;
+            }
+
+            cached = true;
+        }
+    #endif
+
+    for(int ty = tileY; ty < tileY2; ty++) {
+        const int* row = Tilemap->map + ty * Tilemap->w;
+
+        for(int tx = tileX; tx < tileX2; tx++) {
+            if(row[tx] != A_TILEMAP_NONE
+                && (!cached || Tilemap->tiles[row[tx]]->indices)) {
+
+                a_sprite_blit(Tilemap->tiles[row[tx]],
+                              X + tx * Tilemap->tileW,
+                              Y + ty * Tilemap->tileH);
+            }
+        }
+    }
+}
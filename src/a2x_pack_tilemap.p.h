@@ -0,0 +1,39 @@
+/*
+    Copyright 2019 Alex Margarit <alex@alxm.org>
+    This file is part of a2x, a C video game framework.
+
+    This program is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    This program is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with this program.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#pragma once
+
+#include "a2x_system_includes.h"
+
+typedef struct ATilemap ATilemap;
+
+#include "a2x_pack_fix.p.h"
+#include "a2x_pack_spriteframes.p.h"
+
+#define A_TILEMAP_NONE (-1)
+
+extern ATilemap* a_tilemap_new(const ASpriteFrames* Tiles, int Width, int Height, bool Static);
+extern void a_tilemap_free(ATilemap* Tilemap);
+
+extern AVectorInt a_tilemap_sizeGet(const ATilemap* Tilemap);
+extern AVectorInt a_tilemap_tileSizeGet(const ATilemap* Tilemap);
+
+extern int a_tilemap_tileGet(const ATilemap* Tilemap, int X, int Y);
+extern void a_tilemap_tileSet(ATilemap* Tilemap, int X, int Y, int Tile);
+
+extern void a_tilemap_draw(ATilemap* Tilemap, int X, int Y);
@@ -30,80 +30,219 @@ typedef enum {
     A_TIMER__EXPIRED = A_FLAG_BIT(2),
 } ATimerFlags;
 
+typedef enum {
+    A_TIMER__CLOCK_MS,
+    A_TIMER__CLOCK_TICKS,
+    A_TIMER__CLOCK_NUM
+} ATimerClock;
+
+#define A_TIMER__HEAP_NONE UINT_MAX
+
 struct ATimer {
     ATimerType type;
     ATimerFlags flags;
     unsigned period;
     unsigned start;
-    unsigned diff;
-    AListNode* runningListNode;
+    unsigned heapIndex;
+    AListNode* expiredListNode;
 };
 
-static struct {
-    unsigned ms;
-    unsigned ticks;
-} g_now;
+typedef struct {
+    unsigned expire;
+    ATimer* timer;
+} ATimerHeapEntry;
 
-static AList* g_runningTimers; // list of ATimer
+typedef struct {
+    ATimerHeapEntry* entries;
+    unsigned num;
+    unsigned capacity;
+} ATimerHeap;
+
+static unsigned g_now[A_TIMER__CLOCK_NUM];
+static ATimerHeap g_heaps[A_TIMER__CLOCK_NUM]; // running timers by expiry
+static AList* g_expiredTimers; // list of ATimer, expired during last tick
+
+static inline ATimerClock getClock(const ATimer* Timer)
+{
+    return Timer->type == A_TIMER_TICKS
+            ? A_TIMER__CLOCK_TICKS : A_TIMER__CLOCK_MS;
+}
 
 static inline unsigned getNow(const ATimer* Timer)
 {
-    switch(Timer->type) {
-        case A_TIMER_MS:
-        case A_TIMER_SEC:
-            return g_now.ms;
+    return g_now[getClock(Timer)];
+}
+
+static inline bool isBefore(unsigned A, unsigned B)
+{
+    // Wrap-around safe A < B, for times less than INT_MAX apart
+    return (int)(A - B) < 0;
+}
+
+static unsigned periodClamp(ATimerType Type, unsigned Period)
+{
+    // Keeps queued expiry times in isBefore's range
+    if(Type == A_TIMER_SEC) {
+        return Period > INT_MAX / 1000 ? INT_MAX : Period * 1000;
+    }
+
+    return Period > INT_MAX ? INT_MAX : Period;
+}
+
+static inline void heapPlace(ATimerHeap* Heap, unsigned Index, ATimerHeapEntry Entry)
+{
+    Heap->entries[Index] = Entry;
+    Entry.timer->heapIndex = Index;
+}
+
+static void heapSiftUp(ATimerHeap* Heap, unsigned Index)
+{
+    ATimerHeapEntry e = Heap->entries[Index];
+
+    while(Index > 0) {
+        unsigned parent = (Index - 1) / 2;
 
-        case A_TIMER_TICKS:
-            return g_now.ticks;
+        if(!isBefore(e.expire, Heap->entries[parent].expire)) {
+            break;
+        }
 
-        default:
-            return 0;
+        heapPlace(Heap, Index, Heap->entries[parent]);
+        Index = parent;
+    }
+
+    heapPlace(Heap, Index, e);
+}
+
+static void heapSiftDown(ATimerHeap* Heap, unsigned Index)
+{
+    ATimerHeapEntry e = Heap->entries[Index];
+
+    while(true) {
+        unsigned child = Index * 2 + 1;
+
+        if(child >= Heap->num) {
+            break;
+        }
+
+        if(child + 1 < Heap->num
+            && isBefore(Heap->entries[child + 1].expire,
+                        Heap->entries[child].expire)) {
+
+            child++;
+        }
+
+        if(!isBefore(Heap->entries[child].expire, e.expire)) {
+            break;
+        }
+
+        heapPlace(Heap, Index, Heap->entries[child]);
+        Index = child;
+    }
+
+    heapPlace(Heap, Index, e);
+}
+
+static void heapAdd(ATimer* Timer)
+{
+    ATimerHeap* heap = &g_heaps[getClock(Timer)];
+
+    if(heap->num == heap->capacity) {
+        unsigned capacity = heap->capacity < 16 ? 16 : heap->capacity * 2;
+        ATimerHeapEntry* entries =
+            a_mem_malloc(capacity * sizeof(ATimerHeapEntry));
+
+        if(heap->entries) {
+            memcpy(entries,
+                   heap->entries,
+                   heap->num * sizeof(ATimerHeapEntry));
+
+            a_mem_free(heap->entries);
+        }
+
+        heap->entries = entries;
+        heap->capacity = capacity;
+    }
+
+    ATimerHeapEntry e = {Timer->start + Timer->period, Timer};
+
+    heapPlace(heap, heap->num++, e);
+    heapSiftUp(heap, Timer->heapIndex);
+}
+
+static void heapRemove(ATimer* Timer)
+{
+    ATimerHeap* heap = &g_heaps[getClock(Timer)];
+    unsigned index = Timer->heapIndex;
+
+    Timer->heapIndex = A_TIMER__HEAP_NONE;
+
+    if(--heap->num == index) {
+        return;
+    }
+
+    heapPlace(heap, index, heap->entries[heap->num]);
+
+    if(index > 0
+        && isBefore(heap->entries[index].expire,
+                    heap->entries[(index - 1) / 2].expire)) {
+
+        heapSiftUp(heap, index);
+    } else {
+        heapSiftDown(heap, index);
     }
 }
 
 void a_timer__init(void)
 {
-    g_runningTimers = a_list_new();
+    g_expiredTimers = a_list_new();
 }
 
 void a_timer__uninit(void)
 {
-    a_list_free(g_runningTimers);
+    a_list_free(g_expiredTimers);
+
+    for(int c = 0; c < A_TIMER__CLOCK_NUM; c++) {
+        a_mem_free(g_heaps[c].entries);
+    }
 }
 
 void a_timer__tick(void)
 {
-    g_now.ms = a_time_msGet();
-    g_now.ticks = a_fps_ticksGet();
+    g_now[A_TIMER__CLOCK_MS] = a_time_msGet();
+    g_now[A_TIMER__CLOCK_TICKS] = a_fps_ticksGet();
 
-    A_LIST_ITERATE(g_runningTimers, ATimer*, t) {
-        if(!A_FLAG_TEST_ANY(t->flags, A_TIMER__RUNNING)) {
-            // Kick out timer that was marked as not running last frame
-            a_list_removeNode(t->runningListNode);
-            t->runningListNode = NULL;
+    // Expired flag is only set for the tick a timer expired on
+    A_LIST_ITERATE(g_expiredTimers, ATimer*, t) {
+        A_FLAG_CLEAR(t->flags, A_TIMER__EXPIRED);
+        t->expiredListNode = NULL;
+    }
 
-            A_FLAG_CLEAR(t->flags, A_TIMER__EXPIRED);
+    a_list_clear(g_expiredTimers);
 
-            continue;
-        }
+    // Only touch the timers that are due
+    for(int c = 0; c < A_TIMER__CLOCK_NUM; c++) {
+        ATimerHeap* heap = &g_heaps[c];
 
-        t->diff = getNow(t) - t->start;
+        while(heap->num > 0 && !isBefore(g_now[c], heap->entries[0].expire)) {
+            ATimer* t = heap->entries[0].timer;
 
-        if(t->diff >= t->period) {
-            A_FLAG_SET(t->flags, A_TIMER__EXPIRED);
+            heapRemove(t);
 
-            if(A_FLAG_TEST_ANY(t->flags, A_TIMER__REPEAT)) {
-                if(t->period > 0) {
-                    t->start += (t->diff / t->period) * t->period;
-                }
-            } else {
-                t->diff = 0;
+            A_FLAG_SET(t->flags, A_TIMER__EXPIRED);
+            t->expiredListNode = a_list_addLast(g_expiredTimers, t);
+        }
+    }
 
-                // Will be kicked out of running list next frame
-                A_FLAG_CLEAR(t->flags, A_TIMER__RUNNING);
+    // Re-queue after popping, so 0-period timers fire once per tick
+    A_LIST_ITERATE(g_expiredTimers, ATimer*, t) {
+        if(A_FLAG_TEST_ANY(t->flags, A_TIMER__REPEAT)) {
+            if(t->period > 0) {
+                t->start += ((getNow(t) - t->start) / t->period) * t->period;
             }
+
+            heapAdd(t);
         } else {
-            A_FLAG_CLEAR(t->flags, A_TIMER__EXPIRED);
+            A_FLAG_CLEAR(t->flags, A_TIMER__RUNNING);
         }
     }
 }
@@ -112,12 +251,9 @@ ATimer* a_timer_new(ATimerType Type, unsigned Period, bool Repeat)
 {
     ATimer* t = a_mem_zalloc(sizeof(ATimer));
 
-    if(Type == A_TIMER_SEC) {
-        Period *= 1000;
-    }
-
     t->type = Type;
-    t->period = Period;
+    t->period = periodClamp(Type, Period);
+    t->heapIndex = A_TIMER__HEAP_NONE;
 
     if(Repeat) {
         A_FLAG_SET(t->flags, A_TIMER__REPEAT);
@@ -132,8 +268,8 @@ ATimer* a_timer_dup(const ATimer* Timer)
 
     A_FLAG_CLEAR(t->flags, A_TIMER__RUNNING | A_TIMER__EXPIRED);
 
-    t->diff = 0;
-    t->runningListNode = NULL;
+    t->heapIndex = A_TIMER__HEAP_NONE;
+    t->expiredListNode = NULL;
 
     return t;
 }
@@ -144,16 +280,24 @@ void a_timer_free(ATimer* Timer)
         return;
     }
 
-    if(Timer->runningListNode) {
-        a_list_removeNode(Timer->runningListNode);
+    if(Timer->heapIndex != A_TIMER__HEAP_NONE) {
+        heapRemove(Timer);
+    }
+
+    if(Timer->expiredListNode) {
+        a_list_removeNode(Timer->expiredListNode);
     }
 
-    free(Timer);
+    a_mem_free(Timer);
 }
 
 unsigned a_timer_elapsedGet(const ATimer* Timer)
 {
-    return Timer->diff;
+    if(!A_FLAG_TEST_ANY(Timer->flags, A_TIMER__RUNNING)) {
+        return 0;
+    }
+
+    return getNow(Timer) - Timer->start;
 }
 
 unsigned a_timer_periodGet(const ATimer* Timer)
@@ -167,13 +311,14 @@ unsigned a_timer_periodGet(const ATimer* Timer)
 
 void a_timer_periodSet(ATimer* Timer, unsigned Period)
 {
-    if(Timer->type == A_TIMER_SEC) {
-        Period *= 1000;
-    }
+    Timer->period = periodClamp(Timer->type, Period);
 
-    Timer->period = Period;
+    if(Timer->heapIndex != A_TIMER__HEAP_NONE) {
+        heapRemove(Timer);
+        heapAdd(Timer);
+    }
 
-    if(Period == 0 && A_FLAG_TEST_ANY(Timer->flags, A_TIMER__RUNNING)) {
+    if(Timer->period == 0 && A_FLAG_TEST_ANY(Timer->flags, A_TIMER__RUNNING)) {
         A_FLAG_SET(Timer->flags, A_TIMER__EXPIRED);
     }
 }
@@ -181,7 +326,6 @@ void a_timer_periodSet(ATimer* Timer, unsigned Period)
 void a_timer_start(ATimer* Timer)
 {
     Timer->start = getNow(Timer);
-    Timer->diff = 0;
 
     A_FLAG_SET(Timer->flags, A_TIMER__RUNNING);
 
@@ -191,20 +335,19 @@ void a_timer_start(ATimer* Timer)
         A_FLAG_CLEAR(Timer->flags, A_TIMER__EXPIRED);
     }
 
-    if(Timer->runningListNode == NULL) {
-        Timer->runningListNode = a_list_addLast(g_runningTimers, Timer);
+    if(Timer->heapIndex != A_TIMER__HEAP_NONE) {
+        heapRemove(Timer);
     }
+
+    heapAdd(Timer);
 }
 
 void a_timer_stop(ATimer* Timer)
 {
-    Timer->diff = 0;
-
     A_FLAG_CLEAR(Timer->flags, A_TIMER__RUNNING | A_TIMER__EXPIRED);
 
-    if(Timer->runningListNode) {
-        a_list_removeNode(Timer->runningListNode);
-        Timer->runningListNode = NULL;
+    if(Timer->heapIndex != A_TIMER__HEAP_NONE) {
+        heapRemove(Timer);
     }
 }
 
@@ -35,6 +35,12 @@ typedef void AInit(void* Self);
 
 typedef volatile int AEvent;
 
+#if A_CONFIG_LIB_RENDER_SOFTWARE && A_CONFIG_SCREEN_THREADS > 0
+    #define A__THREAD_LOCAL __thread
+#else
+    #define A__THREAD_LOCAL
+#endif
+
 #include <ctype.h>
 #include <float.h>
 #include <limits.h>